@@ -0,0 +1,95 @@
+#ifndef ADAPTIVE_MERGE_H
+#define ADAPTIVE_MERGE_H
+
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+
+// Runs shorter than this are extended with insertion sort before merging
+const size_t kMinRunLength = 32;
+
+// Function to sort data[left, right) with insertion sort, assuming data[left, sortedEnd) is already sorted
+template <typename T, typename Less>
+void extendRun(std::vector<T>& data, size_t left, size_t sortedEnd, size_t right, Less less) {
+    for (size_t i = sortedEnd; i < right; i++) {
+        T value = data[i];
+        size_t j = i;
+        while (j > left && less(value, data[j - 1])) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = value;
+    }
+}
+
+// Function to perform adaptive (natural) merge sort: existing ascending and strictly
+// descending runs are detected and merged, so nearly-sorted input costs close to O(n)
+template <typename T, typename Less>
+void naturalMergeSort(std::vector<T>& data, Less less) {
+    size_t n = data.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Split the input into runs; runs holds the boundaries, starting with 0 and ending with n
+    std::vector<size_t> runs;
+    runs.push_back(0);
+    size_t i = 0;
+    while (i < n) {
+        size_t j = i + 1;
+        if (j < n && less(data[j], data[i])) {
+            while (j < n && less(data[j], data[j - 1])) {
+                j++;
+            }
+            std::reverse(data.begin() + i, data.begin() + j);
+        } else {
+            while (j < n && !less(data[j], data[j - 1])) {
+                j++;
+            }
+        }
+        if (j - i < kMinRunLength && j < n) {
+            size_t end = std::min(i + kMinRunLength, n);
+            extendRun(data, i, j, end, less);
+            j = end;
+        }
+        runs.push_back(j);
+        i = j;
+    }
+
+    // Merge adjacent runs pairwise until a single run is left, alternating between two buffers
+    std::vector<T> buffer(n);
+    std::vector<T>* src = &data;
+    std::vector<T>* dst = &buffer;
+    while (runs.size() > 2) {
+        long numRuns = static_cast<long>(runs.size()) - 1;
+        #pragma omp parallel for schedule(dynamic)
+        for (long r = 0; r < numRuns; r += 2) {
+            size_t lo = runs[r];
+            size_t mid = runs[r + 1];
+            if (r + 1 == numRuns) {
+                // Odd run out, carry it over unchanged
+                std::copy(src->begin() + lo, src->begin() + mid, dst->begin() + lo);
+            } else {
+                size_t hi = runs[r + 2];
+                std::merge(src->begin() + lo, src->begin() + mid, src->begin() + mid, src->begin() + hi,
+                           dst->begin() + lo, less);
+            }
+        }
+
+        std::vector<size_t> merged;
+        for (size_t r = 0; r < runs.size(); r += 2) {
+            merged.push_back(runs[r]);
+        }
+        if (merged.back() != n) {
+            merged.push_back(n);
+        }
+        runs.swap(merged);
+        std::swap(src, dst);
+    }
+
+    if (src != &data) {
+        data.swap(buffer);
+    }
+}
+
+#endif // ADAPTIVE_MERGE_H
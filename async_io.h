@@ -0,0 +1,542 @@
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+// Asynchronous file I/O driven by C++20 coroutines. Reads and writes are submitted to io_uring
+// when the kernel supports it, or to a small pool of threads doing pread/pwrite otherwise.
+// Coroutines run on the thread that calls IoScheduler::run, which resumes them as operations complete.
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define SEO_HAVE_IO_URING 1
+#endif
+
+// Struct to hold one read or write; co_await it to wait for the result (bytes transferred or -errno).
+// Short transfers are resubmitted for the remainder, so fewer bytes than requested means end of file.
+struct IoOp {
+    int fd = -1;
+    struct iovec iov = {};
+    long long offset = 0;
+    bool write = false;
+    long result = 0;
+    size_t transferred = 0;
+    bool done = true;
+    std::coroutine_handle<> waiter;
+
+    // The awaiter refers to the op by pointer, so the completion always finds the waiting coroutine
+    struct Awaiter {
+        IoOp* op;
+
+        bool await_ready() const { return op->done; }
+        void await_suspend(std::coroutine_handle<> h) { op->waiter = h; }
+        long await_resume() const { return op->result; }
+    };
+
+    Awaiter operator co_await() { return Awaiter{this}; }
+};
+
+// Interface of an I/O backend: submit operations and wait for them to complete in any order
+class IoBackend {
+public:
+    virtual ~IoBackend() {}
+    virtual const char* name() const = 0;
+    virtual void submit(IoOp* op) = 0;
+    virtual IoOp* waitCompletion() = 0;
+};
+
+// Backend that performs each operation with pread/pwrite on a pool of threads
+class ThreadPoolBackend : public IoBackend {
+public:
+    explicit ThreadPoolBackend(int numThreads) {
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPoolBackend() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        pendingReady.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    const char* name() const { return "thread pool"; }
+
+    void submit(IoOp* op) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(op);
+        }
+        pendingReady.notify_one();
+    }
+
+    IoOp* waitCompletion() {
+        std::unique_lock<std::mutex> lock(mutex);
+        completedReady.wait(lock, [this] { return !completed.empty(); });
+        IoOp* op = completed.front();
+        completed.pop_front();
+        return op;
+    }
+
+private:
+    void work() {
+        while (true) {
+            IoOp* op;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                pendingReady.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) {
+                    return;
+                }
+                op = pending.front();
+                pending.pop_front();
+            }
+
+            ssize_t n = op->write ? pwrite(op->fd, op->iov.iov_base, op->iov.iov_len, op->offset)
+                                  : pread(op->fd, op->iov.iov_base, op->iov.iov_len, op->offset);
+            op->result = n < 0 ? -errno : n;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                completed.push_back(op);
+            }
+            completedReady.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable pendingReady;
+    std::condition_variable completedReady;
+    std::deque<IoOp*> pending;
+    std::deque<IoOp*> completed;
+    bool stopping = false;
+};
+
+#ifdef SEO_HAVE_IO_URING
+// Backend that talks to io_uring directly through its submission and completion rings
+class UringBackend : public IoBackend {
+public:
+    // Function to set up a ring with the given number of entries; returns nullptr if the kernel refuses
+    static std::unique_ptr<UringBackend> create(unsigned entries) {
+        std::unique_ptr<UringBackend> ring(new UringBackend());
+        if (!ring->init(entries)) {
+            return nullptr;
+        }
+        return ring;
+    }
+
+    ~UringBackend() {
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, sqesSize);
+        }
+        if (cqRing != MAP_FAILED && cqRing != sqRing) {
+            munmap(cqRing, cqRingSize);
+        }
+        if (sqRing != MAP_FAILED) {
+            munmap(sqRing, sqRingSize);
+        }
+        if (ringFd >= 0) {
+            close(ringFd);
+        }
+    }
+
+    const char* name() const { return "io_uring"; }
+
+    void submit(IoOp* op) {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) == sqEntries) {
+            enter(0, 0);
+        }
+        unsigned index = tail & *sqMask;
+        struct io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = op->write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = op->fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(&op->iov);
+        sqe->len = 1;
+        sqe->off = op->offset;
+        sqe->user_data = reinterpret_cast<unsigned long long>(op);
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        unsubmitted++;
+    }
+
+    IoOp* waitCompletion() {
+        // Hand over everything queued since the last call first, so the kernel works on those
+        // operations while the caller processes completions that are already available
+        if (unsubmitted > 0) {
+            enter(0, 0);
+        }
+        while (true) {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                struct io_uring_cqe* cqe = &cqes[head & *cqMask];
+                IoOp* op = reinterpret_cast<IoOp*>(cqe->user_data);
+                op->result = cqe->res;
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                return op;
+            }
+            enter(1, IORING_ENTER_GETEVENTS);
+        }
+    }
+
+private:
+    UringBackend() {}
+
+    bool init(unsigned entries) {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return false;
+        }
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return false;
+        }
+        cqRing = singleMmap ? sqRing
+                            : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return false;
+        }
+        sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqesMap == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<struct io_uring_sqe*>(sqesMap);
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqEntries = params.sq_entries;
+        return true;
+    }
+
+    // Function to hand queued submissions to the kernel and optionally wait for completions
+    void enter(unsigned minComplete, unsigned flags) {
+        int ret;
+        do {
+            ret = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, unsubmitted, minComplete, flags, nullptr, 0));
+        } while (ret < 0 && errno == EINTR);
+        if (ret > 0) {
+            unsubmitted -= std::min<unsigned>(unsubmitted, static_cast<unsigned>(ret));
+        }
+    }
+
+    int ringFd = -1;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    struct io_uring_sqe* sqes = static_cast<struct io_uring_sqe*>(MAP_FAILED);
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+    unsigned *sqHead = nullptr, *sqTail = nullptr, *sqMask = nullptr, *sqArray = nullptr;
+    unsigned *cqHead = nullptr, *cqTail = nullptr, *cqMask = nullptr;
+    struct io_uring_cqe* cqes = nullptr;
+    unsigned sqEntries = 0;
+    unsigned unsubmitted = 0;
+};
+#endif
+
+// Function to pick a backend: io_uring if available, unless SEO_IO_BACKEND=threads asks for the pool
+inline std::unique_ptr<IoBackend> makeIoBackend(unsigned queueDepth) {
+    const char* choice = std::getenv("SEO_IO_BACKEND");
+    bool forceThreads = choice != nullptr && std::strcmp(choice, "threads") == 0;
+#ifdef SEO_HAVE_IO_URING
+    if (!forceThreads) {
+        std::unique_ptr<UringBackend> ring = UringBackend::create(queueDepth);
+        if (ring) {
+            return ring;
+        }
+    }
+#endif
+    (void)forceThreads;
+    return std::unique_ptr<IoBackend>(new ThreadPoolBackend(static_cast<int>(std::min(queueDepth, 8u))));
+}
+
+// Coroutine type for I/O pipelines; starts suspended and is driven by IoScheduler::run
+class Task {
+public:
+    struct promise_type {
+        std::exception_ptr error;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    Task(Task&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+};
+
+// Class to start I/O operations and run coroutines until they finish
+class IoScheduler {
+public:
+    explicit IoScheduler(unsigned queueDepth) : backend(makeIoBackend(queueDepth)) {}
+    explicit IoScheduler(std::unique_ptr<IoBackend> ioBackend) : backend(std::move(ioBackend)) {}
+
+    const char* backendName() const { return backend->name(); }
+
+    // Function to submit an operation without waiting for it; co_await the op later for its result
+    void start(IoOp& op, int fd, void* buffer, size_t length, long long offset, bool write) {
+        op.fd = fd;
+        op.iov.iov_base = buffer;
+        op.iov.iov_len = length;
+        op.offset = offset;
+        op.write = write;
+        op.result = 0;
+        op.transferred = 0;
+        op.done = false;
+        op.waiter = nullptr;
+        backend->submit(&op);
+        inFlight++;
+    }
+
+    // Function to run a task to completion, resuming it whenever an operation it waits on completes
+    void run(Task& task) {
+        task.handle.resume();
+        while (!task.handle.done() && inFlight > 0) {
+            IoOp* op = backend->waitCompletion();
+            if (op->result > 0 && static_cast<size_t>(op->result) < op->iov.iov_len) {
+                // Short transfer: submit the remainder and keep waiting
+                op->transferred += static_cast<size_t>(op->result);
+                op->iov.iov_base = static_cast<char*>(op->iov.iov_base) + op->result;
+                op->iov.iov_len -= static_cast<size_t>(op->result);
+                op->offset += op->result;
+                backend->submit(op);
+                continue;
+            }
+            if (op->result >= 0) {
+                op->result += static_cast<long>(op->transferred);
+            }
+            inFlight--;
+            op->done = true;
+            if (op->waiter) {
+                std::coroutine_handle<> waiter = op->waiter;
+                op->waiter = nullptr;
+                waiter.resume();
+            }
+        }
+        // Drain anything the task left in flight so no buffer is written to after it is freed
+        while (inFlight > 0) {
+            backend->waitCompletion()->done = true;
+            inFlight--;
+        }
+        if (task.handle.promise().error) {
+            std::rethrow_exception(task.handle.promise().error);
+        }
+    }
+
+private:
+    std::unique_ptr<IoBackend> backend;
+    size_t inFlight = 0;
+};
+
+// Size of each buffer used by the line reader and writer, and the number of them kept in flight
+const size_t kIoChunkBytes = 1 << 20;
+const unsigned kIoQueueDepth = 8;
+
+// Function to read a file of lines with several chunk reads in flight, calling parse(begin, end) on
+// each line of a chunk as soon as it arrives while the following chunks are still being read
+template <typename Row, typename ParseFn>
+Task readLinesAsync(IoScheduler& io, int fd, long long fileSize, std::vector<Row>& data, ParseFn parse) {
+    std::vector<std::vector<char>> buffers(kIoQueueDepth, std::vector<char>(kIoChunkBytes));
+    std::vector<IoOp> ops(kIoQueueDepth);
+    std::vector<size_t> lengths(kIoQueueDepth, 0);
+
+    // Prime the queue with the first chunks of the file
+    long long nextOffset = 0;
+    for (unsigned slot = 0; slot < kIoQueueDepth && nextOffset < fileSize; slot++) {
+        lengths[slot] = static_cast<size_t>(std::min<long long>(kIoChunkBytes, fileSize - nextOffset));
+        io.start(ops[slot], fd, buffers[slot].data(), lengths[slot], nextOffset, false);
+        nextOffset += lengths[slot];
+    }
+
+    std::string line;
+    long long readOffset = 0;
+    for (unsigned slot = 0; readOffset < fileSize; slot = (slot + 1) % kIoQueueDepth) {
+        long n = co_await ops[slot];
+        if (n != static_cast<long>(lengths[slot])) {
+            std::cerr << "Error reading file: " << (n < 0 ? std::strerror(static_cast<int>(-n)) : "unexpected end of file") << std::endl;
+            data.clear();
+            co_return;
+        }
+
+        // Split the chunk into lines; a line cut by the chunk boundary is carried over
+        const char* p = buffers[slot].data();
+        const char* end = p + n;
+        while (p < end) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (newline == nullptr) {
+                line.append(p, end);
+                break;
+            }
+            if (line.empty()) {
+                data.push_back(parse(p, newline));
+            } else {
+                line.append(p, newline);
+                data.push_back(parse(line.data(), line.data() + line.size()));
+                line.clear();
+            }
+            p = newline + 1;
+        }
+        readOffset += n;
+
+        // Reuse the buffer for the next chunk
+        if (nextOffset < fileSize) {
+            lengths[slot] = static_cast<size_t>(std::min<long long>(kIoChunkBytes, fileSize - nextOffset));
+            io.start(ops[slot], fd, buffers[slot].data(), lengths[slot], nextOffset, false);
+            nextOffset += lengths[slot];
+        }
+    }
+    if (!line.empty()) {
+        data.push_back(parse(line.data(), line.data() + line.size()));
+    }
+}
+
+// Function to write one line per row through queued writes, calling format(row, buffer, capacity)
+// (snprintf-style) for each; formatting continues into the next buffer while earlier ones are written.
+// A line that does not fit the line buffer is formatted again into a larger one, and a chunk buffer
+// grows to hold a line longer than kIoChunkBytes, so no line is cut. Sets ok to false on an error.
+template <typename Row, typename FormatFn>
+Task writeLinesAsync(IoScheduler& io, int fd, const std::vector<Row>& data, FormatFn format, bool& ok) {
+    std::vector<std::vector<char>> buffers(kIoQueueDepth, std::vector<char>(kIoChunkBytes));
+    std::vector<IoOp> ops(kIoQueueDepth);
+    std::vector<size_t> lengths(kIoQueueDepth, 0);
+    unsigned slot = 0;
+    size_t used = 0;
+    long long offset = 0;
+    std::vector<char> line(4096);
+    ok = true;
+
+    for (size_t i = 0; i <= data.size(); ++i) {
+        size_t length = 0;
+        if (i < data.size()) {
+            int formatted = format(data[i], line.data(), line.size());
+            if (formatted >= 0 && static_cast<size_t>(formatted) >= line.size()) {
+                line.resize(static_cast<size_t>(formatted) + 1);
+                formatted = format(data[i], line.data(), line.size());
+            }
+            if (formatted < 0 || static_cast<size_t>(formatted) >= line.size()) {
+                std::cerr << "Error formatting line " << i << std::endl;
+                ok = false;
+                break;
+            }
+            length = static_cast<size_t>(formatted);
+        }
+
+        // Queue the current buffer when the line does not fit, or at the end, then wait for the
+        // write that last used the next buffer
+        if ((used > 0 && used + length > buffers[slot].size()) || (i == data.size() && used > 0)) {
+            lengths[slot] = used;
+            io.start(ops[slot], fd, buffers[slot].data(), used, offset, true);
+            offset += used;
+            used = 0;
+            slot = (slot + 1) % kIoQueueDepth;
+            long n = co_await ops[slot];
+            if (n != static_cast<long>(lengths[slot])) {
+                std::cerr << "Error writing file: " << (n < 0 ? std::strerror(static_cast<int>(-n)) : "short write") << std::endl;
+                ok = false;
+                co_return;
+            }
+        }
+        if (length > buffers[slot].size()) {
+            buffers[slot].resize(length);
+        }
+        std::memcpy(buffers[slot].data() + used, line.data(), length);
+        used += length;
+    }
+
+    // Wait for every queued write
+    for (unsigned s = 0; s < kIoQueueDepth; s++) {
+        long n = co_await ops[s];
+        if (n != static_cast<long>(lengths[s])) {
+            std::cerr << "Error writing file: " << (n < 0 ? std::strerror(static_cast<int>(-n)) : "short write") << std::endl;
+            ok = false;
+        }
+    }
+}
+
+// Function to load a file of lines with readLinesAsync on the given scheduler
+template <typename Row, typename ParseFn>
+std::vector<Row> loadLinesAsync(IoScheduler& io, const std::string& filename, ParseFn parse) {
+    std::vector<Row> data;
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    Task task = readLinesAsync(io, fd, st.st_size, data, parse);
+    io.run(task);
+    close(fd);
+    return data;
+}
+
+// Function to write one line per row to a file with writeLinesAsync on the given scheduler
+template <typename Row, typename FormatFn>
+bool storeLinesAsync(IoScheduler& io, const std::string& filename, const std::vector<Row>& data, FormatFn format) {
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error opening output file." << std::endl;
+        return false;
+    }
+    bool ok = false;
+    Task task = writeLinesAsync(io, fd, data, format, ok);
+    io.run(task);
+    close(fd);
+    return ok;
+}
+
+#endif // ASYNC_IO_H
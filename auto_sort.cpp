@@ -0,0 +1,706 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#include <omp.h>
+#include "adaptive_merge.h"
+#include "radix_sort.h"
+#include "verify.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Struct to hold the sort key of a row; the row breaks ties so every engine produces the same order
+struct SortRecord {
+    uint64_t key;
+    uint32_t row;
+};
+
+// Engines the auto mode can dispatch to
+enum Engine {
+    kStdSort,
+    kRadixSort,
+    kAdaptiveMerge,
+    kSampleSort,
+    kDenseRankRadix
+};
+
+// Struct to hold the thresholds used to pick an engine; written by --calibrate
+struct TuningProfile {
+    long smallInputRows = 4096;           // below this, std::sort
+    double radixMaxRange = 65536;         // integral keys with a narrower range use radix sort
+    double nearlySortedRatio = 0.02;      // fewer out-of-order neighbours than this use adaptive merge
+    double duplicateRatio = 0.9;          // inputs with more sampled duplicates than this use dense-rank radix
+    long sampleSortMinRows = 0;           // at least this many rows use sample sort on multiple cores;
+                                          // 0 derives it from the L3 cache size
+};
+
+// Struct to hold what was sampled from the input
+struct InputProfile {
+    long rows = 0;
+    double descentRatio = 0.0;
+    double ascentRatio = 0.0;
+    double duplicateRatio = 0.0;
+    bool integral = true;
+    double minKey = 0.0;
+    double maxKey = 0.0;
+};
+
+// Struct to hold the machine characteristics
+struct MachineInfo {
+    int cores = 1;
+    long l2CacheBytes = 0;
+    long l3CacheBytes = 0;
+};
+
+// Number of positions sampled when profiling the input
+const int kProfileSamples = 4096;
+
+// Most distinct keys dense-rank radix sort handles; ranks then fit in two bytes
+const size_t kMaxDenseKeys = 65536;
+
+// Function to convert a string to double, with error handling
+double safeStod(const std::string& str) {
+    try {
+        return std::stod(str);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid argument: " << str << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Out of range: " << str << std::endl;
+    }
+    return 0.0; // Return a default value or handle the error as needed
+}
+
+// Function to read CSV file and extract relevant data
+std::vector<CSVData> readCSV(const std::string& filename) {
+    std::vector<CSVData> data;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string token;
+
+        CSVData rowData;
+        int column = 0;
+        while (std::getline(iss, token, ',')) {
+            switch (column) {
+                case 0: rowData.siteLink = token; break;
+                case 1: rowData.optimizationOpportunities = safeStod(token); break;
+                case 2: rowData.keywordGaps = safeStod(token); break;
+                case 3: rowData.easyToRankKeywords = safeStod(token); break;
+                case 4: rowData.buyerKeywords = safeStod(token); break;
+                case 5: rowData.siteRank = safeStod(token); break;
+                case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+                // Add more cases for additional columns
+            }
+            column++;
+        }
+        data.push_back(rowData);
+    }
+
+    file.close();
+    return data;
+}
+
+// Function to calculate SEO score
+double calculateSEOScore(const CSVData& data) {
+    double Weight_1 = 0.25;
+    double Weight_2 = 0.20;
+    double Weight_3 = 0.15;
+    double Weight_4 = 0.10;
+    double Weight_5 = 0.20;
+    double Weight_6 = 0.10;
+
+    double seoScore = ((data.optimizationOpportunities * Weight_1 + data.keywordGaps * Weight_2 +
+                        data.easyToRankKeywords * Weight_3 + data.buyerKeywords * Weight_4 +
+                        data.siteRank * Weight_5 + data.dailyTimeOnSite * Weight_6) /
+                       (Weight_1 + Weight_2 + Weight_3 + Weight_4 + Weight_5 + Weight_6)) * 100;
+
+    return seoScore;
+}
+
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
+// Function to order two records by key, then by row
+bool recordLess(const SortRecord& a, const SortRecord& b) {
+    return a.key < b.key || (a.key == b.key && a.row < b.row);
+}
+
+// Function to get the name of an engine
+const char* engineName(Engine engine) {
+    switch (engine) {
+        case kStdSort: return "std::sort";
+        case kRadixSort: return "radix sort";
+        case kAdaptiveMerge: return "adaptive merge sort";
+        case kSampleSort: return "sample sort";
+        default: return "dense-rank radix sort";
+    }
+}
+
+// Function to get the path of the tuning profile, overridable with SEO_SORT_PROFILE
+std::string profilePath() {
+    const char* path = std::getenv("SEO_SORT_PROFILE");
+    return path != nullptr ? path : "seo_sort_profile.txt";
+}
+
+// Function to load the tuning profile, keeping defaults for anything missing
+TuningProfile loadProfile(const std::string& filename) {
+    TuningProfile profile;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return profile;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t eq = line.find('=');
+        if (line.empty() || line[0] == '#' || eq == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, eq);
+        double value = safeStod(line.substr(eq + 1));
+        if (name == "smallInputRows") {
+            profile.smallInputRows = static_cast<long>(value);
+        } else if (name == "radixMaxRange") {
+            profile.radixMaxRange = value;
+        } else if (name == "nearlySortedRatio") {
+            profile.nearlySortedRatio = value;
+        } else if (name == "duplicateRatio") {
+            profile.duplicateRatio = value;
+        } else if (name == "sampleSortMinRows") {
+            profile.sampleSortMinRows = static_cast<long>(value);
+        }
+    }
+
+    file.close();
+    return profile;
+}
+
+// Function to save the tuning profile
+bool saveProfile(const std::string& filename, const TuningProfile& profile, const MachineInfo& machine) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error writing profile " << filename << std::endl;
+        return false;
+    }
+    file << "# Calibrated on " << machine.cores << " cores, L2 " << machine.l2CacheBytes
+         << " bytes, L3 " << machine.l3CacheBytes << " bytes" << std::endl;
+    file << "smallInputRows=" << profile.smallInputRows << std::endl;
+    file << "radixMaxRange=" << static_cast<long long>(profile.radixMaxRange) << std::endl;
+    file << "nearlySortedRatio=" << profile.nearlySortedRatio << std::endl;
+    file << "duplicateRatio=" << profile.duplicateRatio << std::endl;
+    file << "sampleSortMinRows=" << profile.sampleSortMinRows << std::endl;
+    file.close();
+    return true;
+}
+
+// Function to query the core count and cache sizes
+MachineInfo detectMachine() {
+    MachineInfo machine;
+    machine.cores = omp_get_num_procs();
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    machine.l2CacheBytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    machine.l3CacheBytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    if (machine.l2CacheBytes <= 0) {
+        machine.l2CacheBytes = 256 * 1024;
+    }
+    if (machine.l3CacheBytes <= 0) {
+        machine.l3CacheBytes = machine.l2CacheBytes;
+    }
+    return machine;
+}
+
+// Function to sample presortedness, duplicates and key range from the input keys
+InputProfile profileInput(const std::vector<double>& keys) {
+    InputProfile input;
+    long n = static_cast<long>(keys.size());
+    input.rows = n;
+    if (n == 0) {
+        return input;
+    }
+
+    double minKey = keys[0], maxKey = keys[0];
+    bool integral = true;
+    #pragma omp parallel for reduction(min:minKey) reduction(max:maxKey) reduction(&&:integral)
+    for (long i = 0; i < n; ++i) {
+        minKey = std::min(minKey, keys[i]);
+        maxKey = std::max(maxKey, keys[i]);
+        integral = integral && keys[i] == std::floor(keys[i]);
+    }
+    input.minKey = minKey;
+    input.maxKey = maxKey;
+    input.integral = integral;
+
+    // Compare neighbours at evenly spaced positions to estimate how sorted the input already is
+    long samples = std::min<long>(kProfileSamples, n - 1);
+    long descents = 0, ascents = 0;
+    std::vector<double> sampled;
+    for (long s = 0; s < samples; s++) {
+        long i = s * (n - 1) / samples;
+        descents += keys[i + 1] < keys[i];
+        ascents += keys[i] < keys[i + 1];
+        sampled.push_back(keys[i]);
+    }
+    if (samples > 0) {
+        input.descentRatio = static_cast<double>(descents) / samples;
+        input.ascentRatio = static_cast<double>(ascents) / samples;
+        std::sort(sampled.begin(), sampled.end());
+        long distinct = std::unique(sampled.begin(), sampled.end()) - sampled.begin();
+        input.duplicateRatio = 1.0 - static_cast<double>(distinct) / samples;
+    }
+    return input;
+}
+
+// Function to get the row count from which sample sort is used. Uncalibrated, that is where radix
+// sort's two record buffers stop fitting in L3 and every radix pass streams from memory.
+long sampleSortMinRows(const MachineInfo& machine, const TuningProfile& profile) {
+    if (profile.sampleSortMinRows > 0) {
+        return profile.sampleSortMinRows;
+    }
+    return machine.l3CacheBytes / static_cast<long>(2 * sizeof(SortRecord));
+}
+
+// Function to pick an engine for the sampled input on this machine
+Engine selectEngine(const InputProfile& input, const MachineInfo& machine, const TuningProfile& profile) {
+    if (input.rows < profile.smallInputRows) {
+        return kStdSort;
+    }
+    if (std::min(input.descentRatio, input.ascentRatio) < profile.nearlySortedRatio) {
+        return kAdaptiveMerge;
+    }
+    if (input.integral && input.maxKey - input.minKey < profile.radixMaxRange) {
+        return kRadixSort;
+    }
+    if (input.duplicateRatio > profile.duplicateRatio) {
+        return kDenseRankRadix;
+    }
+    if (machine.cores > 1 && input.rows >= sampleSortMinRows(machine, profile)) {
+        return kSampleSort;
+    }
+    return kRadixSort;
+}
+
+// Function to build sort records; narrow integral keys are stored as their offset from the minimum
+// so radix sort only needs as many passes as the range has bytes
+std::vector<SortRecord> buildRecords(const std::vector<double>& keys, const InputProfile& input, bool narrow) {
+    std::vector<SortRecord> records(keys.size());
+    #pragma omp parallel for
+    for (long i = 0; i < static_cast<long>(keys.size()); ++i) {
+        records[i].key = narrow ? static_cast<uint64_t>(keys[i] - input.minKey) : orderedKey(keys[i]);
+        records[i].row = static_cast<uint32_t>(i);
+    }
+    return records;
+}
+
+// Function to get the number of low key bytes that can differ between records
+int keyBytes(const InputProfile& input, bool narrow) {
+    if (!narrow) {
+        return 8;
+    }
+    uint64_t range = static_cast<uint64_t>(input.maxKey - input.minKey);
+    int bytes = 1;
+    while (bytes < 8 && (range >> (8 * bytes)) != 0) {
+        bytes++;
+    }
+    return bytes;
+}
+
+// Function to sort records with radix sort over the given number of key bytes
+void radixSortRecords(std::vector<SortRecord>& records, int bytes) {
+    radixSort(records, 0, bytes, [](const SortRecord& r, int b) {
+        return static_cast<unsigned>((r.key >> (8 * b)) & 0xff);
+    });
+}
+
+// Function to build records keyed by each key's rank among the distinct keys, so inputs with few
+// distinct (possibly fractional) keys can be radix sorted on one or two bytes. Keys get ids in an
+// open-addressing table small enough to stay in cache, then ids are replaced by ranks. Returns
+// false if there are more than kMaxDenseKeys distinct keys.
+bool buildDenseRankRecords(const std::vector<double>& keys, std::vector<SortRecord>& records, int& bytes) {
+    const uint32_t kEmpty = 0xffffffffu;
+    std::vector<uint64_t> distinct;
+    std::vector<uint32_t> table(1024, kEmpty);
+    size_t mask = table.size() - 1;
+
+    records.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        uint64_t key = orderedKey(keys[i]);
+        size_t slot = mixHash(key) & mask;
+        while (table[slot] != kEmpty && distinct[table[slot]] != key) {
+            slot = (slot + 1) & mask;
+        }
+        uint32_t id = table[slot];
+        if (id == kEmpty) {
+            if (distinct.size() == kMaxDenseKeys) {
+                return false;
+            }
+            id = static_cast<uint32_t>(distinct.size());
+            table[slot] = id;
+            distinct.push_back(key);
+
+            // Keep the table at most half full
+            if (2 * distinct.size() > table.size()) {
+                table.assign(table.size() * 2, kEmpty);
+                mask = table.size() - 1;
+                for (uint32_t d = 0; d < distinct.size(); d++) {
+                    size_t s = mixHash(distinct[d]) & mask;
+                    while (table[s] != kEmpty) {
+                        s = (s + 1) & mask;
+                    }
+                    table[s] = d;
+                }
+            }
+        }
+        records[i].key = id;
+        records[i].row = static_cast<uint32_t>(i);
+    }
+
+    // Replace ids, numbered in order of first appearance, by ranks in key order
+    std::vector<uint32_t> byKey(distinct.size());
+    for (uint32_t id = 0; id < distinct.size(); id++) {
+        byKey[id] = id;
+    }
+    std::sort(byKey.begin(), byKey.end(), [&distinct](uint32_t a, uint32_t b) {
+        return distinct[a] < distinct[b];
+    });
+    std::vector<uint32_t> rankOf(distinct.size());
+    for (uint32_t r = 0; r < byKey.size(); r++) {
+        rankOf[byKey[r]] = r;
+    }
+    #pragma omp parallel for
+    for (long i = 0; i < static_cast<long>(records.size()); ++i) {
+        records[i].key = rankOf[records[i].key];
+    }
+    bytes = distinct.size() <= 256 ? 1 : 2;
+    return true;
+}
+
+// Function to perform parallel sample sort: records are scattered into buckets between sampled
+// splitters and every bucket, sized to fit in L2, is sorted independently
+void sampleSort(std::vector<SortRecord>& records, const MachineInfo& machine) {
+    long n = static_cast<long>(records.size());
+    int numThreads = omp_get_max_threads();
+    long bucketTarget = std::max<long>(1024, machine.l2CacheBytes / static_cast<long>(sizeof(SortRecord)) / 2);
+    int numBuckets = static_cast<int>(std::min<long>(4096, std::max<long>(numThreads * 4, n / bucketTarget)));
+    if (n < 2 * numBuckets) {
+        std::sort(records.begin(), records.end(), recordLess);
+        return;
+    }
+
+    // Oversample evenly spaced records and take every oversample-th one as a splitter
+    const int oversample = 32;
+    std::vector<SortRecord> samples;
+    long numSamples = static_cast<long>(numBuckets) * oversample;
+    for (long s = 0; s < numSamples; s++) {
+        samples.push_back(records[s * n / numSamples]);
+    }
+    std::sort(samples.begin(), samples.end(), recordLess);
+    std::vector<SortRecord> splitters;
+    for (int b = 1; b < numBuckets; b++) {
+        splitters.push_back(samples[static_cast<size_t>(b) * oversample]);
+    }
+
+    std::vector<uint16_t> bucketOf(n);
+    std::vector<long> counts(static_cast<size_t>(numThreads) * numBuckets, 0);
+    std::vector<long> bucketStart(numBuckets + 1, 0);
+    std::vector<SortRecord> buffer(n);
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        int t = omp_get_thread_num();
+        int team = omp_get_num_threads();
+        long begin = n * t / team;
+        long end = n * (t + 1) / team;
+        long* local = &counts[static_cast<size_t>(t) * numBuckets];
+
+        // Classify this thread's slice
+        for (long i = begin; i < end; i++) {
+            int b = std::upper_bound(splitters.begin(), splitters.end(), records[i], recordLess) - splitters.begin();
+            bucketOf[i] = static_cast<uint16_t>(b);
+            local[b]++;
+        }
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            long offset = 0;
+            for (int b = 0; b < numBuckets; b++) {
+                bucketStart[b] = offset;
+                for (int u = 0; u < team; u++) {
+                    long c = counts[static_cast<size_t>(u) * numBuckets + b];
+                    counts[static_cast<size_t>(u) * numBuckets + b] = offset;
+                    offset += c;
+                }
+            }
+            bucketStart[numBuckets] = offset;
+        }
+
+        for (long i = begin; i < end; i++) {
+            buffer[local[bucketOf[i]]++] = records[i];
+        }
+
+        #pragma omp barrier
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < numBuckets; b++) {
+            std::sort(buffer.begin() + bucketStart[b], buffer.begin() + bucketStart[b + 1], recordLess);
+        }
+    }
+
+    records.swap(buffer);
+}
+
+// Function to build the records an engine sorts and the number of key bytes its radix passes need.
+// Dense-rank radix falls back to full-key radix sort when the input has too many distinct keys.
+std::vector<SortRecord> prepareRecords(Engine& engine, const std::vector<double>& keys, const InputProfile& input,
+                                       double narrowRange, int& bytes) {
+    std::vector<SortRecord> records;
+    if (engine == kDenseRankRadix) {
+        if (buildDenseRankRecords(keys, records, bytes)) {
+            return records;
+        }
+        engine = kRadixSort;
+    }
+    bool narrow = engine == kRadixSort && input.integral && input.maxKey - input.minKey < narrowRange;
+    bytes = keyBytes(input, narrow);
+    return buildRecords(keys, input, narrow);
+}
+
+// Function to sort records with the given engine
+void runEngine(Engine engine, std::vector<SortRecord>& records, const MachineInfo& machine, int bytes) {
+    switch (engine) {
+        case kStdSort:
+            std::sort(records.begin(), records.end(), recordLess);
+            break;
+        case kRadixSort:
+        case kDenseRankRadix:
+            radixSortRecords(records, bytes);
+            break;
+        case kAdaptiveMerge:
+            naturalMergeSort(records, recordLess);
+            break;
+        case kSampleSort:
+            sampleSort(records, machine);
+            break;
+    }
+}
+
+// Function to time one engine on a set of keys, including building its records, best of three runs, in seconds
+double timeEngine(Engine engine, const std::vector<double>& keys, const MachineInfo& machine) {
+    InputProfile input = profileInput(keys);
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+        Engine used = engine;
+        int bytes = 8;
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<SortRecord> records = prepareRecords(used, keys, input, 4294967296.0, bytes);
+        runEngine(used, records, machine, bytes);
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Function to generate calibration keys: uniform integers in [0, range) with the first
+// fraction `perturbed` of adjacent pairs swapped after sorting when presorted is set
+std::vector<double> calibrationKeys(long n, double range, bool presorted, double perturbed, std::mt19937& rng) {
+    std::uniform_real_distribution<double> dist(0.0, range);
+    std::vector<double> keys(n);
+    for (auto& k : keys) {
+        k = std::floor(dist(rng));
+    }
+    if (presorted) {
+        std::sort(keys.begin(), keys.end());
+        std::uniform_int_distribution<long> position(0, n - 2);
+        long swaps = static_cast<long>(perturbed * n);
+        for (long s = 0; s < swaps; s++) {
+            long i = position(rng);
+            std::swap(keys[i], keys[i + 1]);
+        }
+    }
+    return keys;
+}
+
+// Function to measure the crossover points between engines on this machine
+TuningProfile calibrate(const MachineInfo& machine) {
+    TuningProfile profile;
+    std::mt19937 rng(7);
+    const double wideRange = 1e12;
+
+    // Smallest size at which the best parallel engine beats std::sort on random keys
+    profile.smallInputRows = 1L << 20;
+    for (long n = 256; n <= (1L << 20); n *= 2) {
+        std::vector<double> keys = calibrationKeys(n, wideRange, false, 0.0, rng);
+        double stdTime = timeEngine(kStdSort, keys, machine);
+        double bestOther = std::min(timeEngine(kRadixSort, keys, machine), timeEngine(kSampleSort, keys, machine));
+        if (bestOther < stdTime) {
+            profile.smallInputRows = n;
+            break;
+        }
+    }
+
+    const long n = 1L << 20;
+
+    // Largest fraction of out-of-order neighbours at which adaptive merge still wins
+    profile.nearlySortedRatio = 0.0;
+    const double ratios[] = {0.001, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2};
+    for (double ratio : ratios) {
+        std::vector<double> keys = calibrationKeys(n, wideRange, true, ratio, rng);
+        double mergeTime = timeEngine(kAdaptiveMerge, keys, machine);
+        double bestOther = std::min(timeEngine(kRadixSort, keys, machine), timeEngine(kSampleSort, keys, machine));
+        if (mergeTime >= bestOther) {
+            break;
+        }
+        profile.nearlySortedRatio = profileInput(keys).descentRatio + 1e-9;
+    }
+
+    // Widest integral key range at which narrow radix sort still beats sample sort
+    profile.radixMaxRange = 0.0;
+    for (double range = 256; range <= 4294967296.0; range *= 16) {
+        std::vector<double> keys = calibrationKeys(n, range, false, 0.0, rng);
+        if (timeEngine(kRadixSort, keys, machine) >= timeEngine(kSampleSort, keys, machine)) {
+            break;
+        }
+        profile.radixMaxRange = range;
+    }
+
+    // Smallest sampled duplicate ratio at which dense-rank radix still beats the full-key engines,
+    // going from few distinct fractional keys to many
+    profile.duplicateRatio = 1.0;
+    std::uniform_real_distribution<double> fraction(0.0, 100.0);
+    for (long distinctKeys = 16; distinctKeys <= static_cast<long>(kMaxDenseKeys); distinctKeys *= 4) {
+        std::vector<double> values(distinctKeys);
+        for (auto& v : values) {
+            v = fraction(rng); // Full-precision fractions rule out narrow radix sort
+        }
+        std::vector<double> keys = calibrationKeys(n, static_cast<double>(distinctKeys), false, 0.0, rng);
+        for (auto& k : keys) {
+            k = values[static_cast<size_t>(k)];
+        }
+        double denseTime = timeEngine(kDenseRankRadix, keys, machine);
+        double bestOther = std::min(timeEngine(kRadixSort, keys, machine), timeEngine(kSampleSort, keys, machine));
+        if (denseTime >= bestOther) {
+            break;
+        }
+        profile.duplicateRatio = profileInput(keys).duplicateRatio - 1e-9;
+    }
+
+    // Smallest size at which sample sort beats full-key radix sort on random keys
+    profile.sampleSortMinRows = 1L << 30;
+    for (long rows = 1L << 12; rows <= n; rows *= 2) {
+        std::vector<double> keys = calibrationKeys(rows, wideRange, false, 0.0, rng);
+        for (auto& k : keys) {
+            k += 0.5; // Fractional keys force the full 8-byte radix sort
+        }
+        if (timeEngine(kSampleSort, keys, machine) < timeEngine(kRadixSort, keys, machine)) {
+            profile.sampleSortMinRows = rows;
+            break;
+        }
+    }
+
+    return profile;
+}
+
+int main(int argc, char* argv[]) {
+    MachineInfo machine = detectMachine();
+
+    if (argc > 1 && std::string(argv[1]) == "--calibrate") {
+        TuningProfile profile = calibrate(machine);
+        if (!saveProfile(profilePath(), profile, machine)) {
+            return 1;
+        }
+        std::cout << "Wrote " << profilePath() << ": smallInputRows=" << profile.smallInputRows
+                  << " radixMaxRange=" << profile.radixMaxRange
+                  << " nearlySortedRatio=" << profile.nearlySortedRatio
+                  << " duplicateRatio=" << profile.duplicateRatio
+                  << " sampleSortMinRows=" << profile.sampleSortMinRows << std::endl;
+        return 0;
+    }
+
+    std::string filename = argc > 1 ? argv[1] : "/home/divi/alexa.com_site_info.csv";
+    std::vector<CSVData> data = readCSV(filename);
+    TuningProfile profile = loadProfile(profilePath());
+
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Profile the input and dispatch to the best engine for it
+    std::vector<double> keys(data.size());
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.size(); ++i) {
+        keys[i] = sortKey(data[i]);
+    }
+    InputProfile input = profileInput(keys);
+    Engine engine = selectEngine(input, machine, profile);
+    int bytes = 8;
+    std::vector<SortRecord> records = prepareRecords(engine, keys, input, profile.radixMaxRange, bytes);
+    std::vector<SortRecord> sequentialRecords = records;
+    runEngine(engine, records, machine, bytes);
+
+    std::vector<CSVData> sortedData(data.size());
+    #pragma omp parallel for
+    for (size_t i = 0; i < records.size(); ++i) {
+        sortedData[i] = std::move(data[records[i].row]);
+    }
+    data.swap(sortedData);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsedSeconds = end - start;
+
+    double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
+
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
+    // Sequential version
+    start = std::chrono::high_resolution_clock::now();
+    std::sort(sequentialRecords.begin(), sequentialRecords.end(), recordLess);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> sequentialTime = end - start;
+
+    double speedup = sequentialTime.count() / elapsedSeconds.count();
+
+    // Output the sorted data, SEO scores, the chosen engine, sorting rate, speedup, and number of threads or cores used
+    for (const auto& d : data) {
+        std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
+    }
+    std::cout << "Engine: " << engineName(engine) << " (rows " << input.rows
+              << ", out-of-order neighbours " << std::min(input.descentRatio, input.ascentRatio)
+              << ", duplicates " << input.duplicateRatio
+              << ", key range " << input.maxKey - input.minKey << (input.integral ? " integral" : "")
+              << ", sample sort from " << sampleSortMinRows(machine, profile) << " rows, L3 "
+              << machine.l3CacheBytes << " bytes)" << std::endl;
+    std::cout << "Sorting rate: " << sortingRate << " elements per second" << std::endl;
+    std::cout << "Time taken to sort: " << elapsedSeconds.count() << " seconds" << std::endl;
+    std::cout << "Speedup: " << speedup << std::endl;
+    std::cout << "Number of threads/cores: " << omp_get_max_threads() << std::endl;
+
+    return 0;
+}
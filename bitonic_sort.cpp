@@ -5,6 +5,8 @@
 #include <chrono>
 #include <algorithm>
 #include <omp.h>
+#include "leaf_kernels.h"
+#include "verify.h"
 
 // Struct to hold data from CSV file
 struct CSVData {
@@ -83,33 +85,58 @@ double calculateSEOScore(const CSVData& data) {
     return seoScore;
 }
 
-// Bitonic merge function
+// Sequences at or below this length are finished by the leaf kernels
+const int kBitonicLeafSize = 16;
+
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
+// Sort key passed to the leaf kernels; a lambda rather than a function pointer so the key loads inline
+const auto leafKey = [](const CSVData& data) { return sortKey(data); };
+
+// Sequences longer than this are split into OpenMP tasks
+const int kBitonicTaskSize = 4096;
+
+// Function to get the largest power of two below length (length must be at least 2)
+int largestPowerOfTwoBelow(int length) {
+    int k = 1;
+    while (k * 2 < length) {
+        k *= 2;
+    }
+    return k;
+}
+
+// Bitonic merge function; works for any length, so no padding is needed
 void bitonicMerge(std::vector<CSVData>& data, int start, int length, bool direction) {
-    if (length > 1) {
-        int k = length / 2;
-        for (int i = start; i < start + k; i++) {
+    if (length <= kBitonicLeafSize) {
+        sortLeaf(data, start, start + length - 1, leafKey, direction);
+    } else {
+        int k = largestPowerOfTwoBelow(length);
+        for (int i = start; i < start + length - k; i++) {
             if ((data[i].optimizationOpportunities > data[i + k].optimizationOpportunities) == direction) {
                 std::swap(data[i], data[i + k]);
             }
         }
+        #pragma omp task shared(data) if(length > kBitonicTaskSize)
         bitonicMerge(data, start, k, direction);
-        bitonicMerge(data, start + k, k, direction);
+        bitonicMerge(data, start + k, length - k, direction);
+        #pragma omp taskwait
     }
 }
 
-// Bitonic sort function
+// Bitonic sort function; must be called from inside a parallel region so its tasks can run
 void bitonicSort(std::vector<CSVData>& data, int start, int length, bool direction) {
-    if (length > 1) {
+    if (length <= kBitonicLeafSize) {
+        sortLeaf(data, start, start + length - 1, leafKey, direction);
+    } else {
         int k = length / 2;
-        // Sort in ascending order
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            bitonicSort(data, start, k, true);
-
-            #pragma omp section
-            bitonicSort(data, start + k, k, false);
-        }
+        // Sort the first half against the final direction and the second half along it
+        #pragma omp task shared(data) if(length > kBitonicTaskSize)
+        bitonicSort(data, start, k, !direction);
+        bitonicSort(data, start + k, length - k, direction);
+        #pragma omp taskwait
         bitonicMerge(data, start, length, direction);
     }
 }
@@ -118,6 +145,11 @@ int main() {
     std::string filename = "/home/divi/alexa.com_site_info.csv";
     std::vector<CSVData> data = readCSV(filename);
 
+    // Keep an unsorted copy for the sequential baseline, and checksum the input when verifying
+    std::vector<CSVData> sequentialData = data;
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
+
     auto start = std::chrono::high_resolution_clock::now();
 
     // Calculate SEO scores for all data
@@ -128,14 +160,11 @@ int main() {
     }
 
     // Sort the data using parallel bitonic sort
-    int n = data.size();
-    for (int k = 2; k <= n; k *= 2) {
-        for (int j = k / 2; j > 0; j /= 2) {
-            #pragma omp parallel for
-            for (int i = 0; i < n; i += k) {
-                bitonicSort(data, i, j, true);
-                bitonicSort(data, i + j, j, false);
-            }
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            bitonicSort(data, 0, data.size(), true);
         }
     }
 
@@ -145,7 +174,7 @@ int main() {
     // Calculate speedup
     auto startSequential = std::chrono::high_resolution_clock::now();
     // Perform sequential sorting here
-    std::sort(data.begin(), data.end(), [](const CSVData& a, const CSVData& b) {
+    std::sort(sequentialData.begin(), sequentialData.end(), [](const CSVData& a, const CSVData& b) {
         return a.optimizationOpportunities < b.optimizationOpportunities;
     });
     auto endSequential = std::chrono::high_resolution_clock::now();
@@ -155,6 +184,10 @@ int main() {
     // Calculate sorting rate
     double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
 
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
     // Output the sorted data, SEO scores, sorting rate, speedup, and time taken to sort
     for (const auto& d : data) {
         std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
@@ -0,0 +1,423 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <malloc.h>
+#include <omp.h>
+#include "adaptive_merge.h"
+#include "radix_sort.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Number of weighted metrics in the SEO score
+const int kNumMetrics = 6;
+
+// Weight_1..Weight_6 from calculateSEOScore
+const double kWeights[kNumMetrics] = {0.25, 0.20, 0.15, 0.10, 0.20, 0.10};
+
+// Number of top-ranked sites compared between the double and compact rankings
+const int kTopK = 100;
+
+// Struct to hold a full-precision sort key: the ordered double score and its row
+struct ScoreRow {
+    uint64_t key;
+    uint32_t row;
+};
+
+// Function to convert a string to double, with error handling
+double safeStod(const std::string& str) {
+    try {
+        return std::stod(str);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid argument: " << str << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Out of range: " << str << std::endl;
+    }
+    return 0.0; // Return a default value or handle the error as needed
+}
+
+// Function to read CSV file and extract relevant data
+std::vector<CSVData> readCSV(const std::string& filename) {
+    std::vector<CSVData> data;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string token;
+
+        CSVData rowData;
+        int column = 0;
+        while (std::getline(iss, token, ',')) {
+            switch (column) {
+                case 0: rowData.siteLink = token; break;
+                case 1: rowData.optimizationOpportunities = safeStod(token); break;
+                case 2: rowData.keywordGaps = safeStod(token); break;
+                case 3: rowData.easyToRankKeywords = safeStod(token); break;
+                case 4: rowData.buyerKeywords = safeStod(token); break;
+                case 5: rowData.siteRank = safeStod(token); break;
+                case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+                // Add more cases for additional columns
+            }
+            column++;
+        }
+        data.push_back(rowData);
+    }
+
+    file.close();
+    return data;
+}
+
+// Function to get metric k of a row
+double metric(const CSVData& data, int k) {
+    switch (k) {
+        case 0: return data.optimizationOpportunities;
+        case 1: return data.keywordGaps;
+        case 2: return data.easyToRankKeywords;
+        case 3: return data.buyerKeywords;
+        case 4: return data.siteRank;
+        default: return data.dailyTimeOnSite;
+    }
+}
+
+// Function to get the weights normalised and scaled by 100 like calculateSEOScore
+void scaledWeights(double scaled[kNumMetrics]) {
+    double total = 0.0;
+    for (int k = 0; k < kNumMetrics; k++) {
+        total += kWeights[k];
+    }
+    for (int k = 0; k < kNumMetrics; k++) {
+        scaled[k] = kWeights[k] / total * 100;
+    }
+}
+
+// Function to read the resident set size of this process in bytes
+long residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Function to store the metrics as float32 columns
+std::vector<float> buildFloatColumns(const std::vector<CSVData>& data) {
+    size_t n = data.size();
+    std::vector<float> columns(kNumMetrics * n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < kNumMetrics; k++) {
+            columns[k * n + i] = static_cast<float>(metric(data[i], k));
+        }
+    }
+    return columns;
+}
+
+// Function to convert a metric to fixed point with the given scale; like rank_sort, -inf is
+// clamped to the smallest value and +inf and NaN to the largest
+int32_t toFixed(double value, double scale) {
+    if (std::isfinite(value)) {
+        return static_cast<int32_t>(std::lround(value * scale));
+    }
+    return value < 0.0 ? -2147483647 : 2147483647;
+}
+
+// Function to store the metrics as fixed-point int32 columns; each column gets the largest
+// power-of-two scale that keeps its largest finite magnitude in range
+std::vector<int32_t> buildFixedColumns(const std::vector<CSVData>& data, double scale[kNumMetrics]) {
+    size_t n = data.size();
+    for (int k = 0; k < kNumMetrics; k++) {
+        double maxAbs = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double value = metric(data[i], k);
+            if (std::isfinite(value)) {
+                maxAbs = std::max(maxAbs, std::fabs(value));
+            }
+        }
+        // The exponent is capped so a column of tiny magnitudes still gets a finite scale
+        scale[k] = maxAbs > 0.0 ? std::exp2(std::min(std::floor(std::log2(2147483647.0 / maxAbs)), 1000.0)) : 1.0;
+    }
+
+    std::vector<int32_t> columns(kNumMetrics * n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < kNumMetrics; k++) {
+            columns[k * n + i] = toFixed(metric(data[i], k), scale[k]);
+        }
+    }
+    return columns;
+}
+
+// Function to pack a float score and its row into one 64-bit key; ascending key order is
+// descending score with ties broken by row
+uint64_t packScore(float score, uint32_t row) {
+    return (static_cast<uint64_t>(~orderedKey(score)) << 32) | row;
+}
+
+// Function to pack a fixed-point int32 score and its row into one 64-bit key, ordered like packScore
+uint64_t packFixedScore(int32_t score, uint32_t row) {
+    uint32_t ordered = static_cast<uint32_t>(score) ^ 0x80000000u;
+    return (static_cast<uint64_t>(~ordered) << 32) | row;
+}
+
+// Function to recover the score packed into a key by packScore
+double unpackScore(uint64_t key) {
+    uint32_t ordered = ~static_cast<uint32_t>(key >> 32);
+    uint32_t bits = (ordered >> 31) ? ordered & 0x7fffffffu : ~ordered;
+    float score;
+    std::memcpy(&score, &bits, sizeof(score));
+    return score;
+}
+
+// Function to recover the score packed into a key by packFixedScore; the int32 score counts
+// units of 2^exponent
+double unpackFixedScore(uint64_t key, int exponent) {
+    uint32_t ordered = ~static_cast<uint32_t>(key >> 32);
+    return std::ldexp(static_cast<double>(static_cast<int32_t>(ordered ^ 0x80000000u)), exponent);
+}
+
+// Function to turn the score weights into int64 fixed-point weights for int32 columns with the
+// given scales: score * 2^fraction = sum of column value * weight. fraction is the largest that
+// keeps the weights summing to at most 2^31, so six int32 * weight products cannot overflow int64.
+void fixedWeights(const double weights[kNumMetrics], const double scale[kNumMetrics],
+                  int64_t fixed[kNumMetrics], int& fraction) {
+    double total = 0.0;
+    for (int k = 0; k < kNumMetrics; k++) {
+        total += std::fabs(weights[k] / scale[k]);
+    }
+    bool usable = total > 0.0 && std::isfinite(total) && std::isfinite(2147483647.0 / total);
+    fraction = usable ? static_cast<int>(std::floor(std::log2(2147483647.0 / total))) : 0;
+    for (int k = 0; k < kNumMetrics; k++) {
+        fixed[k] = std::llround(std::ldexp(weights[k] / scale[k], fraction));
+    }
+}
+
+// Function to compute Spearman's rank correlation between two rankings given as row -> position
+double spearmanCorrelation(const std::vector<uint32_t>& rankA, const std::vector<uint32_t>& rankB) {
+    double n = static_cast<double>(rankA.size());
+    if (rankA.size() < 2) {
+        return 1.0;
+    }
+    double sumSquares = 0.0;
+    #pragma omp parallel for reduction(+:sumSquares)
+    for (size_t i = 0; i < rankA.size(); ++i) {
+        double d = static_cast<double>(rankA[i]) - static_cast<double>(rankB[i]);
+        sumSquares += d * d;
+    }
+    return 1.0 - 6.0 * sumSquares / (n * (n * n - 1.0));
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = argc > 1 ? argv[1] : "/home/divi/alexa.com_site_info.csv";
+    bool useFixedPoint = argc > 2 && std::string(argv[2]) == "fixed";
+    std::vector<CSVData> data = readCSV(filename);
+    if (data.empty()) {
+        std::cerr << "No rows to sort." << std::endl;
+        return 1;
+    }
+
+    size_t n = data.size();
+    double weights[kNumMetrics];
+    scaledWeights(weights);
+    std::vector<double> doubleScores(n);
+    std::vector<uint32_t> doubleRank(n), compactRank(n);
+
+    // Double path: 64-bit metric columns, scores and 16-byte (key, row) records
+    long rssStart = residentBytes();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<double> columns(kNumMetrics * n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        for (int k = 0; k < kNumMetrics; k++) {
+            columns[k * n + i] = metric(data[i], k);
+        }
+    }
+
+    std::vector<ScoreRow> rows(n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        double score = 0.0;
+        for (int k = 0; k < kNumMetrics; k++) {
+            score += columns[k * n + i] * weights[k];
+        }
+        doubleScores[i] = score;
+        rows[i].key = ~orderedKey(score);
+        rows[i].row = static_cast<uint32_t>(i);
+    }
+    std::vector<ScoreRow> mergeRows = rows;
+
+    auto radixStart = std::chrono::high_resolution_clock::now();
+    radixSort(rows, 0, 8, [](const ScoreRow& r, int b) {
+        return static_cast<unsigned>((r.key >> (8 * b)) & 0xff);
+    });
+    auto radixEnd = std::chrono::high_resolution_clock::now();
+    naturalMergeSort(mergeRows, [](const ScoreRow& a, const ScoreRow& b) {
+        return a.key < b.key || (a.key == b.key && a.row < b.row);
+    });
+    auto mergeEnd = std::chrono::high_resolution_clock::now();
+
+    long rssDouble = residentBytes() - rssStart;
+    std::chrono::duration<double> doubleScoring = radixStart - start;
+    std::chrono::duration<double> doubleRadix = radixEnd - radixStart;
+    std::chrono::duration<double> doubleMerge = mergeEnd - radixEnd;
+    for (size_t pos = 0; pos < n; pos++) {
+        doubleRank[rows[pos].row] = static_cast<uint32_t>(pos);
+    }
+    std::vector<double>().swap(columns);
+    std::vector<ScoreRow>().swap(rows);
+    std::vector<ScoreRow>().swap(mergeRows);
+    malloc_trim(0);
+
+    // Compact path: 32-bit metric columns and 8-byte packed (score, row) keys
+    rssStart = residentBytes();
+    start = std::chrono::high_resolution_clock::now();
+
+    std::vector<float> floatColumns;
+    std::vector<int32_t> fixedColumns;
+    std::vector<uint64_t> keys(n);
+    int scoreExponent = 0;
+    if (useFixedPoint) {
+        // Accumulate exact int64 products, then keep the top 32 bits the scores actually use
+        double scale[kNumMetrics];
+        int64_t fixed[kNumMetrics];
+        int fraction = 0;
+        fixedColumns = buildFixedColumns(data, scale);
+        fixedWeights(weights, scale, fixed, fraction);
+
+        int64_t maxAbsScore = 0;
+        #pragma omp parallel for reduction(max:maxAbsScore)
+        for (size_t i = 0; i < n; ++i) {
+            int64_t score = 0;
+            for (int k = 0; k < kNumMetrics; k++) {
+                score += static_cast<int64_t>(fixedColumns[k * n + i]) * fixed[k];
+            }
+            keys[i] = static_cast<uint64_t>(score);
+            maxAbsScore = std::max(maxAbsScore, score < 0 ? -score : score);
+        }
+        int shift = 0;
+        while ((maxAbsScore >> shift) > 2147483647LL) {
+            shift++;
+        }
+        scoreExponent = shift - fraction;
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < n; ++i) {
+            int64_t score = static_cast<int64_t>(keys[i]);
+            keys[i] = packFixedScore(static_cast<int32_t>(score >> shift), static_cast<uint32_t>(i));
+        }
+    } else {
+        float floatWeights[kNumMetrics];
+        for (int k = 0; k < kNumMetrics; k++) {
+            floatWeights[k] = static_cast<float>(weights[k]);
+        }
+        floatColumns = buildFloatColumns(data);
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < n; ++i) {
+            float score = 0.0f;
+            for (int k = 0; k < kNumMetrics; k++) {
+                score += floatColumns[k * n + i] * floatWeights[k];
+            }
+            keys[i] = packScore(score, static_cast<uint32_t>(i));
+        }
+    }
+    auto compactScore = [useFixedPoint, scoreExponent](uint64_t key) {
+        return useFixedPoint ? unpackFixedScore(key, scoreExponent) : unpackScore(key);
+    };
+    std::vector<uint64_t> mergeKeys = keys;
+
+    // The row half of each key is already in ascending order, so only the score bytes need passes
+    radixStart = std::chrono::high_resolution_clock::now();
+    radixSort(keys, 4, 8, [](uint64_t key, int b) {
+        return static_cast<unsigned>((key >> (8 * b)) & 0xff);
+    });
+    radixEnd = std::chrono::high_resolution_clock::now();
+    naturalMergeSort(mergeKeys, [](uint64_t a, uint64_t b) {
+        return a < b;
+    });
+    mergeEnd = std::chrono::high_resolution_clock::now();
+
+    long rssCompact = residentBytes() - rssStart;
+    std::chrono::duration<double> compactScoring = radixStart - start;
+    std::chrono::duration<double> compactRadix = radixEnd - radixStart;
+    std::chrono::duration<double> compactMerge = mergeEnd - radixEnd;
+    for (size_t pos = 0; pos < n; pos++) {
+        compactRank[static_cast<uint32_t>(keys[pos])] = static_cast<uint32_t>(pos);
+    }
+
+    // Ranking error of the compact path against the double path; rows whose double score is not
+    // finite are ranked but left out of the score error, which has no meaning for them
+    double maxScoreError = 0.0;
+    long maxDisplacement = 0;
+    double sumDisplacement = 0.0;
+    long movedRows = 0;
+    long nonFiniteRows = 0;
+    #pragma omp parallel for reduction(max:maxScoreError, maxDisplacement) reduction(+:sumDisplacement, movedRows, nonFiniteRows)
+    for (size_t i = 0; i < n; ++i) {
+        if (std::isfinite(doubleScores[i])) {
+            maxScoreError = std::max(maxScoreError, std::fabs(compactScore(keys[compactRank[i]]) - doubleScores[i]));
+        } else {
+            nonFiniteRows++;
+        }
+        long displacement = std::labs(static_cast<long>(compactRank[i]) - static_cast<long>(doubleRank[i]));
+        maxDisplacement = std::max(maxDisplacement, displacement);
+        sumDisplacement += displacement;
+        movedRows += displacement != 0;
+    }
+    int k = static_cast<int>(std::min<size_t>(kTopK, n));
+    int topKOverlap = 0;
+    for (int pos = 0; pos < k; pos++) {
+        if (doubleRank[static_cast<uint32_t>(keys[pos])] < static_cast<uint32_t>(k)) {
+            topKOverlap++;
+        }
+    }
+
+    // Output the top sites under the compact ranking, the ranking error and the throughput of both paths
+    for (int pos = 0; pos < k; pos++) {
+        uint32_t row = static_cast<uint32_t>(keys[pos]);
+        std::cout << "SEO Score for " << data[row].siteLink << ": " << compactScore(keys[pos]) << std::endl;
+    }
+    std::cout << "Compact mode: " << (useFixedPoint ? "fixed-point int32" : "float32") << std::endl;
+    if (useFixedPoint) {
+        std::cout << "Fixed-point score unit: 2^" << scoreExponent << std::endl;
+    }
+    std::cout << "Max score error: " << maxScoreError << std::endl;
+    if (nonFiniteRows > 0) {
+        std::cout << "Rows with non-finite scores (left out of the score error): " << nonFiniteRows << std::endl;
+    }
+    std::cout << "Rows ranked differently: " << movedRows << " of " << n << std::endl;
+    std::cout << "Mean rank displacement: " << sumDisplacement / n << ", max: " << maxDisplacement << std::endl;
+    std::cout << "Spearman vs double ranking: " << spearmanCorrelation(doubleRank, compactRank) << std::endl;
+    std::cout << "Top-" << k << " overlap: " << topKOverlap << "/" << k << std::endl;
+    std::cout << "Double path: score " << doubleScoring.count() << " s, radix sort "
+              << n / doubleRadix.count() << " elements per second, merge sort "
+              << n / doubleMerge.count() << " elements per second, RSS growth " << rssDouble / 1048576.0 << " MiB" << std::endl;
+    std::cout << "Compact path: score " << compactScoring.count() << " s, radix sort "
+              << n / compactRadix.count() << " elements per second, merge sort "
+              << n / compactMerge.count() << " elements per second, RSS growth " << rssCompact / 1048576.0 << " MiB" << std::endl;
+    std::cout << "Column bytes per row: " << kNumMetrics * sizeof(double) << " -> " << kNumMetrics * 4
+              << ", key bytes per row: " << sizeof(ScoreRow) << " -> " << sizeof(uint64_t) << std::endl;
+    std::cout << "Number of threads/cores: " << omp_get_max_threads() << std::endl;
+
+    return 0;
+}
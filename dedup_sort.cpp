@@ -0,0 +1,346 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <omp.h>
+#include "front_coded_dictionary.h"
+#include "verify.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Struct to hold one deduplicated site: its id in the site dictionary and its merged metrics
+struct SiteRow {
+    uint32_t siteId;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+};
+
+// How repeated rows of the same site are combined
+enum MergePolicy {
+    kMergeLatest,   // keep the row that appears last in the file
+    kMergeMax,      // keep the largest value of each metric
+    kMergeAverage   // average each metric over all rows
+};
+
+// Number of weighted metrics per row
+const int kNumMetrics = 6;
+
+// Number of independently locked shards in the site table
+const int kNumShards = 64;
+
+// Number of lines read before they are parsed and merged in parallel
+const size_t kIngestBatchLines = 1 << 16;
+
+// Struct to hold the metrics merged so far for one site
+struct SiteAggregate {
+    double values[kNumMetrics];
+    long row;
+    long count;
+};
+
+// Struct to hold one shard of the site table
+struct SiteShard {
+    std::mutex mutex;
+    std::unordered_map<std::string, SiteAggregate> sites;
+};
+
+// Class to deduplicate sites by URL from many threads; each URL maps to one shard, so threads
+// only contend when they merge sites that hash to the same shard
+class SiteTable {
+public:
+    // Function to merge one row of a site into the table under the given policy
+    void merge(std::string&& site, const double values[kNumMetrics], long row, MergePolicy policy) {
+        SiteShard& shard = shards[std::hash<std::string>()(site) % kNumShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sites.find(site);
+        if (it == shard.sites.end()) {
+            SiteAggregate aggregate;
+            std::copy(values, values + kNumMetrics, aggregate.values);
+            aggregate.row = row;
+            aggregate.count = 1;
+            shard.sites.emplace(std::move(site), aggregate);
+            return;
+        }
+
+        SiteAggregate& aggregate = it->second;
+        for (int k = 0; k < kNumMetrics; k++) {
+            switch (policy) {
+                case kMergeLatest:
+                    if (row > aggregate.row) {
+                        aggregate.values[k] = values[k];
+                    }
+                    break;
+                case kMergeMax:
+                    aggregate.values[k] = std::max(aggregate.values[k], values[k]);
+                    break;
+                case kMergeAverage:
+                    aggregate.values[k] += values[k];
+                    break;
+            }
+        }
+        aggregate.row = std::max(aggregate.row, row);
+        aggregate.count++;
+    }
+
+    SiteShard shards[kNumShards];
+};
+
+// Function to convert a string to double, with error handling
+double safeStod(const std::string& str) {
+    try {
+        return std::stod(str);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid argument: " << str << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Out of range: " << str << std::endl;
+    }
+    return 0.0; // Return a default value or handle the error as needed
+}
+
+// Function to parse one CSV line into the same fields as readCSV
+CSVData parseCSVLine(const std::string& line) {
+    std::istringstream iss(line);
+    std::string token;
+
+    CSVData rowData = {};
+    int column = 0;
+    while (std::getline(iss, token, ',')) {
+        switch (column) {
+            case 0: rowData.siteLink = token; break;
+            case 1: rowData.optimizationOpportunities = safeStod(token); break;
+            case 2: rowData.keywordGaps = safeStod(token); break;
+            case 3: rowData.easyToRankKeywords = safeStod(token); break;
+            case 4: rowData.buyerKeywords = safeStod(token); break;
+            case 5: rowData.siteRank = safeStod(token); break;
+            case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+            // Add more cases for additional columns
+        }
+        column++;
+    }
+    return rowData;
+}
+
+// Function to read CSV file and extract relevant data
+std::vector<CSVData> readCSV(const std::string& filename) {
+    std::vector<CSVData> data;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        data.push_back(parseCSVLine(line));
+    }
+
+    file.close();
+    return data;
+}
+
+// Function to read a CSV file straight into the site table, parsing and merging each batch of
+// lines in parallel. Returns the number of rows read, or -1 if the file cannot be opened.
+long ingestCSV(const std::string& filename, SiteTable& table, MergePolicy policy) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> lines(kIngestBatchLines);
+    long rows = 0;
+    while (true) {
+        size_t batch = 0;
+        while (batch < kIngestBatchLines && std::getline(file, lines[batch])) {
+            batch++;
+        }
+        if (batch == 0) {
+            break;
+        }
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < batch; ++i) {
+            CSVData row = parseCSVLine(lines[i]);
+            double values[kNumMetrics] = {row.optimizationOpportunities, row.keywordGaps, row.easyToRankKeywords,
+                                          row.buyerKeywords, row.siteRank, row.dailyTimeOnSite};
+            table.merge(std::move(row.siteLink), values, rows + static_cast<long>(i), policy);
+        }
+        rows += static_cast<long>(batch);
+    }
+
+    file.close();
+    return rows;
+}
+
+// Function to turn the site table into a front-coded dictionary of URLs and one row per site,
+// emptying the table as it goes
+std::vector<SiteRow> buildSiteRows(SiteTable& table, MergePolicy policy, FrontCodedDictionary& dictionary) {
+    std::vector<std::pair<std::string, SiteAggregate>> sites;
+    for (auto& shard : table.shards) {
+        while (!shard.sites.empty()) {
+            auto node = shard.sites.extract(shard.sites.begin());
+            sites.emplace_back(std::move(node.key()), node.mapped());
+        }
+        std::unordered_map<std::string, SiteAggregate>().swap(shard.sites);
+    }
+    std::sort(sites.begin(), sites.end(), [](const std::pair<std::string, SiteAggregate>& a,
+                                             const std::pair<std::string, SiteAggregate>& b) {
+        return a.first < b.first;
+    });
+
+    // Ids follow the sorted URL order, which is also the order front coding needs
+    std::vector<std::string> urls(sites.size());
+    std::vector<SiteRow> rows(sites.size());
+    #pragma omp parallel for
+    for (size_t i = 0; i < sites.size(); ++i) {
+        const SiteAggregate& aggregate = sites[i].second;
+        double scale = policy == kMergeAverage ? 1.0 / aggregate.count : 1.0;
+        rows[i].siteId = static_cast<uint32_t>(i);
+        rows[i].optimizationOpportunities = aggregate.values[0] * scale;
+        rows[i].keywordGaps = aggregate.values[1] * scale;
+        rows[i].easyToRankKeywords = aggregate.values[2] * scale;
+        rows[i].buyerKeywords = aggregate.values[3] * scale;
+        rows[i].siteRank = aggregate.values[4] * scale;
+        rows[i].dailyTimeOnSite = aggregate.values[5] * scale;
+        urls[i] = std::move(sites[i].first);
+    }
+    std::vector<std::pair<std::string, SiteAggregate>>().swap(sites);
+
+    dictionary.build(urls);
+    return rows;
+}
+
+// Function to check that every id in the dictionary maps back to itself through its URL; prints the
+// first mismatch and returns false if front coding lost or reordered a URL
+bool verifyDictionary(const FrontCodedDictionary& dictionary, size_t count) {
+    long n = static_cast<long>(count);
+    long mismatch = n;
+    #pragma omp parallel for reduction(min:mismatch)
+    for (long id = 0; id < n; ++id) {
+        if (id < mismatch && dictionary.find(dictionary.lookup(static_cast<uint32_t>(id))) != id) {
+            mismatch = id;
+        }
+    }
+    if (mismatch < n) {
+        std::cerr << "Verification failed: dictionary id " << mismatch << " (" << dictionary.lookup(static_cast<uint32_t>(mismatch))
+                  << ") does not map back to itself" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Function to estimate the memory held by rows kept as CSVData, including URL strings on the heap
+size_t rowBytes(const std::vector<CSVData>& data) {
+    size_t bytes = data.capacity() * sizeof(CSVData);
+    for (const auto& d : data) {
+        if (d.siteLink.capacity() > 15) {
+            bytes += d.siteLink.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+// Function to calculate SEO score
+double calculateSEOScore(const SiteRow& data) {
+    double Weight_1 = 0.25;
+    double Weight_2 = 0.20;
+    double Weight_3 = 0.15;
+    double Weight_4 = 0.10;
+    double Weight_5 = 0.20;
+    double Weight_6 = 0.10;
+
+    double seoScore = ((data.optimizationOpportunities * Weight_1 + data.keywordGaps * Weight_2 +
+                        data.easyToRankKeywords * Weight_3 + data.buyerKeywords * Weight_4 +
+                        data.siteRank * Weight_5 + data.dailyTimeOnSite * Weight_6) /
+                       (Weight_1 + Weight_2 + Weight_3 + Weight_4 + Weight_5 + Weight_6)) * 100;
+
+    return seoScore;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = argc > 1 ? argv[1] : "/home/divi/alexa.com_site_info.csv";
+    std::string policyName = argc > 2 ? argv[2] : "latest";
+    MergePolicy policy;
+    if (policyName == "latest") {
+        policy = kMergeLatest;
+    } else if (policyName == "max") {
+        policy = kMergeMax;
+    } else if (policyName == "average") {
+        policy = kMergeAverage;
+    } else {
+        std::cerr << "Unknown merge policy " << policyName << " (use latest, max or average)" << std::endl;
+        return 1;
+    }
+
+    // Baseline: every row kept as CSVData and sorted as the sort programs do
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<CSVData> data = readCSV(filename);
+    auto loaded = std::chrono::high_resolution_clock::now();
+    std::sort(data.begin(), data.end(), [](const CSVData& a, const CSVData& b) {
+        return a.optimizationOpportunities < b.optimizationOpportunities;
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> rawLoadTime = loaded - start;
+    std::chrono::duration<double> rawSortTime = end - loaded;
+    size_t rawRows = data.size();
+    size_t rawBytes = rowBytes(data);
+    std::vector<CSVData>().swap(data);
+
+    // Deduplicated ingestion: one row per site, URLs replaced by dictionary ids
+    start = std::chrono::high_resolution_clock::now();
+    std::unique_ptr<SiteTable> table(new SiteTable());
+    if (ingestCSV(filename, *table, policy) < 0) {
+        return 1;
+    }
+    FrontCodedDictionary dictionary;
+    std::vector<SiteRow> sites = buildSiteRows(*table, policy, dictionary);
+    table.reset();
+    loaded = std::chrono::high_resolution_clock::now();
+    std::sort(sites.begin(), sites.end(), [](const SiteRow& a, const SiteRow& b) {
+        return a.optimizationOpportunities < b.optimizationOpportunities ||
+               (a.optimizationOpportunities == b.optimizationOpportunities && a.siteId < b.siteId);
+    });
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> dedupLoadTime = loaded - start;
+    std::chrono::duration<double> dedupSortTime = end - loaded;
+    size_t dedupBytes = sites.capacity() * sizeof(SiteRow) + dictionary.bytes();
+
+    if (verificationEnabled() && !verifyDictionary(dictionary, sites.size())) {
+        return 1;
+    }
+
+    // Output the sorted sites, SEO scores, and the memory and time of both paths
+    for (const auto& s : sites) {
+        std::cout << "SEO Score for " << dictionary.lookup(s.siteId) << ": " << calculateSEOScore(s) << std::endl;
+    }
+    std::cout << "Merge policy: " << policyName << std::endl;
+    std::cout << "Rows: " << rawRows << ", unique sites: " << sites.size() << std::endl;
+    std::cout << "Row memory: " << rawBytes / 1048576.0 << " MiB -> " << dedupBytes / 1048576.0
+              << " MiB (dictionary " << dictionary.bytes() / 1048576.0 << " MiB)" << std::endl;
+    std::cout << "Load time: " << rawLoadTime.count() << " s -> " << dedupLoadTime.count() << " s" << std::endl;
+    std::cout << "Time taken to sort: " << rawSortTime.count() << " s -> " << dedupSortTime.count() << " s" << std::endl;
+    std::cout << "Number of threads/cores: " << omp_get_max_threads() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <omp.h>
+#include "leaf_kernels.h"
+#include "verify.h"
+#ifdef __cpp_impl_coroutine
+#include <cstdio>
+#include "async_io.h"
+#endif
+
+// Each engine is a standalone program; compile each one into a namespace of its own, with its
+// main renamed, so its sort function can be driven directly. Headers an engine includes are
+// included here first, so their include guards keep them out of the engine namespaces.
+#define main quickSortMain
+namespace quick {
+#include "quick_sort.cpp"
+}
+#undef main
+#define main mergeSortMain
+namespace merge {
+#include "merge_sort.cpp"
+}
+#undef main
+#define main bitonicSortMain
+namespace bitonic {
+#include "bitonic_sort.cpp"
+}
+#undef main
+#define main rankSortMain
+namespace rank {
+#include "rank_sort.cpp"
+}
+#undef main
+#define main oddEvenSortMain
+namespace oddeven {
+#include "oddeven_sort.cpp"
+}
+#undef main
+
+// Input sizes tested: empty and tiny inputs, sizes around the leaf threshold and around powers
+// of two, and a few large odd and power-of-two sizes
+const int kTestSizes[] = {0, 1, 2, 3, 15, 16, 17, 33, 100, 1000, 1023, 1024, 1025, 4096, 65536, 100003};
+
+// Odd-even sort takes quadratic time, so it is only run up to this size
+const int kOddEvenMaxSize = 4096;
+
+// Thread counts every engine is run with
+const int kThreadCounts[] = {1, 2, 4};
+
+// Key distributions tested
+enum Distribution {
+    kRandom,          // integers spread over a wide range
+    kDuplicateHeavy,  // only four distinct keys
+    kPresorted,       // already ascending
+    kReversed,        // descending
+    kFractional,      // reals, many sharing an integer part
+    kNegative,        // reals of both signs
+    kInfinite,        // integers mixed with +inf and -inf
+    kNumDistributions
+};
+
+const char* distributionName(int distribution) {
+    static const char* names[] = {"random", "duplicate-heavy", "presorted", "reversed",
+                                  "fractional", "negative", "infinite"};
+    return names[distribution];
+}
+
+// Function to generate n keys of the given distribution
+std::vector<double> generateKeys(int distribution, int n, std::mt19937_64& rng) {
+    std::vector<double> keys(n);
+    std::uniform_int_distribution<int> wide(0, 1000000);
+    std::uniform_int_distribution<int> few(0, 3);
+    std::uniform_real_distribution<double> fraction(0.0, 8.0);
+    std::uniform_real_distribution<double> signedReal(-1000.0, 1000.0);
+    for (int i = 0; i < n; i++) {
+        switch (distribution) {
+            case kRandom: keys[i] = wide(rng); break;
+            case kDuplicateHeavy: keys[i] = few(rng); break;
+            case kPresorted: keys[i] = i / 3; break;
+            case kReversed: keys[i] = n - i; break;
+            case kFractional: keys[i] = fraction(rng); break;
+            case kNegative: keys[i] = signedReal(rng); break;
+            case kInfinite: {
+                int pick = few(rng);
+                keys[i] = pick == 0 ? std::numeric_limits<double>::infinity()
+                        : pick == 1 ? -std::numeric_limits<double>::infinity()
+                        : static_cast<double>(wide(rng) % 100);
+                break;
+            }
+        }
+    }
+    return keys;
+}
+
+// Function to build rows of an engine's CSVData type from keys; every other field is derived
+// from the row number, so rows that get mixed up or duplicated change the checksum
+template <typename Row>
+std::vector<Row> makeRows(const std::vector<double>& keys) {
+    std::vector<Row> rows(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        rows[i].siteLink = "site" + std::to_string(i) + ".com";
+        rows[i].optimizationOpportunities = keys[i];
+        rows[i].keywordGaps = static_cast<double>(i);
+        rows[i].easyToRankKeywords = static_cast<double>(i % 7);
+        rows[i].buyerKeywords = static_cast<double>(i % 11);
+        rows[i].siteRank = static_cast<double>(keys.size() - i);
+        rows[i].dailyTimeOnSite = static_cast<double>(i) / 4;
+    }
+    return rows;
+}
+
+// Function to run one engine on the keys and compare its key order and checksum with the
+// std::stable_sort reference; prints the first difference and returns false on mismatch
+template <typename Row, typename SortFn>
+bool checkEngine(const char* engine, const std::vector<double>& keys, const std::vector<double>& expectedKeys,
+                 uint64_t expectedChecksum, SortFn sortFn) {
+    std::vector<Row> rows = makeRows<Row>(keys);
+    sortFn(rows);
+
+    if (rows.size() != expectedKeys.size()) {
+        std::cerr << engine << ": " << rows.size() << " rows out, expected " << expectedKeys.size() << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (rows[i].optimizationOpportunities != expectedKeys[i]) {
+            std::cerr << engine << ": key " << rows[i].optimizationOpportunities << " at row " << i
+                      << ", expected " << expectedKeys[i] << std::endl;
+            return false;
+        }
+    }
+    if (permutationChecksum(rows) != expectedChecksum) {
+        std::cerr << engine << ": output is not a permutation of the input" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned long long seed = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20240601ULL;
+    std::cout << "Seed: " << seed << std::endl;
+
+    int runs = 0;
+    int failures = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int threads : kThreadCounts) {
+        omp_set_num_threads(threads);
+        for (int distribution = 0; distribution < kNumDistributions; distribution++) {
+            for (int n : kTestSizes) {
+                std::mt19937_64 rng(seed ^ mixHash(static_cast<uint64_t>(distribution) << 32 | n));
+                std::vector<double> keys = generateKeys(distribution, n, rng);
+
+                // Reference: std::stable_sort on the same rows
+                std::vector<quick::CSVData> reference = makeRows<quick::CSVData>(keys);
+                uint64_t expectedChecksum = permutationChecksum(reference);
+                std::stable_sort(reference.begin(), reference.end(), [](const quick::CSVData& a, const quick::CSVData& b) {
+                    return a.optimizationOpportunities < b.optimizationOpportunities;
+                });
+                std::vector<double> expectedKeys(n);
+                for (int i = 0; i < n; i++) {
+                    expectedKeys[i] = reference[i].optimizationOpportunities;
+                }
+
+                bool passed = true;
+                passed &= checkEngine<quick::CSVData>("quick_sort", keys, expectedKeys, expectedChecksum,
+                                                      [](std::vector<quick::CSVData>& data) {
+                    #pragma omp parallel
+                    {
+                        #pragma omp single
+                        {
+                            quick::parallelQuicksort(data, 0, data.size() - 1);
+                        }
+                    }
+                });
+                passed &= checkEngine<merge::CSVData>("merge_sort", keys, expectedKeys, expectedChecksum,
+                                                      [](std::vector<merge::CSVData>& data) {
+                    #pragma omp parallel
+                    {
+                        #pragma omp single
+                        {
+                            merge::mergeSort(data, 0, data.size() - 1);
+                        }
+                    }
+                });
+                passed &= checkEngine<bitonic::CSVData>("bitonic_sort", keys, expectedKeys, expectedChecksum,
+                                                        [](std::vector<bitonic::CSVData>& data) {
+                    #pragma omp parallel
+                    {
+                        #pragma omp single
+                        {
+                            bitonic::bitonicSort(data, 0, data.size(), true);
+                        }
+                    }
+                });
+                passed &= checkEngine<rank::CSVData>("rank_sort", keys, expectedKeys, expectedChecksum,
+                                                     [](std::vector<rank::CSVData>& data) {
+                    rank::rankSort(data);
+                });
+                runs += 4;
+                if (n <= kOddEvenMaxSize) {
+                    passed &= checkEngine<oddeven::CSVData>("oddeven_sort", keys, expectedKeys, expectedChecksum,
+                                                            [](std::vector<oddeven::CSVData>& data) {
+                        oddeven::oddEvenSort(data, data.size());
+                    });
+                    runs++;
+                }
+
+                if (!passed) {
+                    std::cerr << "  (" << distributionName(distribution) << " keys, " << n << " rows, "
+                              << threads << " threads, seed " << seed << ")" << std::endl;
+                    failures++;
+                }
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsedSeconds = end - start;
+
+    std::cout << "Engine runs: " << runs << ", failed cases: " << failures << std::endl;
+    std::cout << "Time taken: " << elapsedSeconds.count() << " seconds" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#ifndef FRONT_CODED_DICTIONARY_H
+#define FRONT_CODED_DICTIONARY_H
+
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Class to store a sorted list of strings compactly. Strings are grouped in blocks; the first
+// string of a block is stored whole and every other one as the length of the prefix it shares
+// with its predecessor plus the remaining suffix. A string's id is its position in the sorted list.
+class FrontCodedDictionary {
+public:
+    static const int kBlockSize = 16;
+
+    // Function to build the dictionary from strings that are already sorted and unique
+    void build(const std::vector<std::string>& sorted) {
+        blob.clear();
+        blockOffsets.clear();
+        count = sorted.size();
+        for (size_t i = 0; i < sorted.size(); i++) {
+            size_t shared = 0;
+            if (i % kBlockSize == 0) {
+                blockOffsets.push_back(blob.size());
+            } else {
+                const std::string& previous = sorted[i - 1];
+                while (shared < previous.size() && shared < sorted[i].size() && previous[shared] == sorted[i][shared]) {
+                    shared++;
+                }
+            }
+            putVarint(shared);
+            putVarint(sorted[i].size() - shared);
+            blob.insert(blob.end(), sorted[i].begin() + shared, sorted[i].end());
+        }
+        blob.shrink_to_fit();
+        blockOffsets.shrink_to_fit();
+    }
+
+    // Function to get the string with the given id
+    std::string lookup(uint32_t id) const {
+        std::string value;
+        size_t pos = blockOffsets[id / kBlockSize];
+        for (uint32_t i = id - id % kBlockSize; i <= id; i++) {
+            size_t shared = getVarint(pos);
+            size_t suffix = getVarint(pos);
+            value.resize(shared);
+            value.append(blob.data() + pos, suffix);
+            pos += suffix;
+        }
+        return value;
+    }
+
+    // Function to get the id of a string, or -1 if it is not in the dictionary
+    long find(const std::string& value) const {
+        // Binary search for the last block whose first string is not greater than value
+        size_t lo = 0, hi = blockOffsets.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (lookup(static_cast<uint32_t>(mid * kBlockSize)) <= value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == 0) {
+            return -1;
+        }
+        uint32_t first = static_cast<uint32_t>((lo - 1) * kBlockSize);
+        uint32_t last = static_cast<uint32_t>(std::min(count, static_cast<size_t>(first) + kBlockSize));
+        for (uint32_t id = first; id < last; id++) {
+            if (lookup(id) == value) {
+                return id;
+            }
+        }
+        return -1;
+    }
+
+    size_t size() const { return count; }
+
+    // Function to get the memory held by the encoded strings and block index
+    size_t bytes() const { return blob.capacity() + blockOffsets.capacity() * sizeof(size_t); }
+
+private:
+    void putVarint(size_t value) {
+        while (value >= 0x80) {
+            blob.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        blob.push_back(static_cast<char>(value));
+    }
+
+    size_t getVarint(size_t& pos) const {
+        size_t value = 0;
+        int shift = 0;
+        while (true) {
+            unsigned char byte = static_cast<unsigned char>(blob[pos++]);
+            value |= static_cast<size_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+            shift += 7;
+        }
+    }
+
+    std::vector<char> blob;
+    std::vector<size_t> blockOffsets;
+    size_t count = 0;
+};
+
+#endif // FRONT_CODED_DICTIONARY_H
@@ -0,0 +1,239 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "async_io.h"
+#include "verify.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Function to convert a string to double, with error handling
+double safeStod(const std::string& str) {
+    try {
+        return std::stod(str);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid argument: " << str << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Out of range: " << str << std::endl;
+    }
+    return 0.0; // Return a default value or handle the error as needed
+}
+
+// Function to parse one CSV line into the same fields as readCSV, splitting on commas in place
+// instead of going through an istringstream
+CSVData parseCSVLine(const char* begin, const char* end) {
+    CSVData rowData = {};
+    int column = 0;
+    const char* p = begin;
+    while (p < end) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', end - p));
+        const char* tokenEnd = comma != nullptr ? comma : end;
+        std::string token(p, tokenEnd);
+        switch (column) {
+            case 0: rowData.siteLink = token; break;
+            case 1: rowData.optimizationOpportunities = safeStod(token); break;
+            case 2: rowData.keywordGaps = safeStod(token); break;
+            case 3: rowData.easyToRankKeywords = safeStod(token); break;
+            case 4: rowData.buyerKeywords = safeStod(token); break;
+            case 5: rowData.siteRank = safeStod(token); break;
+            case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+            // Add more cases for additional columns
+        }
+        column++;
+        p = comma != nullptr ? comma + 1 : end;
+    }
+    return rowData;
+}
+
+// Function to read CSV file and extract relevant data
+std::vector<CSVData> readCSV(const std::string& filename) {
+    std::vector<CSVData> data;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        data.push_back(parseCSVLine(line.data(), line.data() + line.size()));
+    }
+
+    file.close();
+    return data;
+}
+
+// Function to calculate SEO score
+double calculateSEOScore(const CSVData& data) {
+    double Weight_1 = 0.25;
+    double Weight_2 = 0.20;
+    double Weight_3 = 0.15;
+    double Weight_4 = 0.10;
+    double Weight_5 = 0.20;
+    double Weight_6 = 0.10;
+
+    double seoScore = ((data.optimizationOpportunities * Weight_1 + data.keywordGaps * Weight_2 +
+                        data.easyToRankKeywords * Weight_3 + data.buyerKeywords * Weight_4 +
+                        data.siteRank * Weight_5 + data.dailyTimeOnSite * Weight_6) /
+                       (Weight_1 + Weight_2 + Weight_3 + Weight_4 + Weight_5 + Weight_6)) * 100;
+
+    return seoScore;
+}
+
+// Function to write the SEO score lines the way the sort programs do, through a blocking stream
+void writeScores(const std::string& filename, const std::vector<CSVData>& data) {
+    std::ofstream out(filename);
+    for (const auto& d : data) {
+        out << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
+    }
+}
+
+// Function to format the SEO score line of a row the way writeScores does, snprintf-style
+int formatScore(const CSVData& data, char* line, size_t capacity) {
+    return std::snprintf(line, capacity, "SEO Score for %s: %g\n", data.siteLink.c_str(), calculateSEOScore(data));
+}
+
+// Function to evict a file from the page cache so the next read comes from the device
+void dropFromCache(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Function to load the file with the async pipeline on the given scheduler
+std::vector<CSVData> loadAsync(IoScheduler& io, const std::string& filename) {
+    return loadLinesAsync<CSVData>(io, filename, parseCSVLine);
+}
+
+// Function to write the scores with the async pipeline on the given scheduler; returns false on error
+bool storeAsync(IoScheduler& io, const std::string& filename, const std::vector<CSVData>& data) {
+    return storeLinesAsync(io, filename, data, formatScore);
+}
+
+// Function to build rows whose score lines outgrow the async writer's 4 KB line buffer and its
+// 1 MiB chunk buffers, mixed with short rows, to check that long lines are written whole
+std::vector<CSVData> longLineRows() {
+    std::vector<CSVData> rows;
+    const size_t urlLengths[] = {12, 5000, 12, 2 << 20, 4096, 12};
+    for (size_t i = 0; i < sizeof(urlLengths) / sizeof(urlLengths[0]); i++) {
+        CSVData row = {};
+        row.siteLink = std::string(urlLengths[i], 'a' + i) + ".com";
+        row.optimizationOpportunities = static_cast<double>(i);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+// Function to read a whole file into memory, used to check that both writers produce the same bytes
+std::string fileContents(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = argc > 1 ? argv[1] : "/home/divi/alexa.com_site_info.csv";
+    std::string outputName = argc > 2 ? argv[2] : "seo_scores_io_bench.txt";
+
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) {
+        std::cerr << "Error opening file." << std::endl;
+        return 1;
+    }
+    double megabytes = st.st_size / 1048576.0;
+
+    IoScheduler uring(kIoQueueDepth);
+    IoScheduler pool(std::unique_ptr<IoBackend>(new ThreadPoolBackend(kIoQueueDepth)));
+    std::cout << "File: " << filename << " (" << megabytes << " MiB), async backend: " << uring.backendName() << std::endl;
+
+    // Load the file with each reader, first from a cold page cache and then warm
+    std::vector<CSVData> reference;
+    const char* caches[] = {"cold", "warm"};
+    for (const char* cache : caches) {
+        bool cold = std::string(cache) == "cold";
+
+        if (cold) dropFromCache(filename);
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<CSVData> streamData = readCSV(filename);
+        std::chrono::duration<double> streamTime = std::chrono::high_resolution_clock::now() - start;
+
+        if (cold) dropFromCache(filename);
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<CSVData> uringData = loadAsync(uring, filename);
+        std::chrono::duration<double> uringTime = std::chrono::high_resolution_clock::now() - start;
+
+        if (cold) dropFromCache(filename);
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<CSVData> poolData = loadAsync(pool, filename);
+        std::chrono::duration<double> poolTime = std::chrono::high_resolution_clock::now() - start;
+
+        uint64_t checksum = permutationChecksum(streamData);
+        if (uringData.size() != streamData.size() || permutationChecksum(uringData) != checksum ||
+            poolData.size() != streamData.size() || permutationChecksum(poolData) != checksum) {
+            std::cerr << "Async readers returned different rows than readCSV" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Load (" << cache << " cache): stream " << megabytes / streamTime.count() << " MiB/s, "
+                  << uring.backendName() << " " << megabytes / uringTime.count() << " MiB/s, "
+                  << pool.backendName() << " " << megabytes / poolTime.count() << " MiB/s" << std::endl;
+        reference.swap(streamData);
+    }
+
+    // Write the score lines with each writer
+    auto start = std::chrono::high_resolution_clock::now();
+    writeScores(outputName, reference);
+    std::chrono::duration<double> streamTime = std::chrono::high_resolution_clock::now() - start;
+    std::string expected = fileContents(outputName);
+
+    start = std::chrono::high_resolution_clock::now();
+    storeAsync(uring, outputName, reference);
+    std::chrono::duration<double> uringTime = std::chrono::high_resolution_clock::now() - start;
+    bool uringMatches = fileContents(outputName) == expected;
+
+    start = std::chrono::high_resolution_clock::now();
+    storeAsync(pool, outputName, reference);
+    std::chrono::duration<double> poolTime = std::chrono::high_resolution_clock::now() - start;
+    bool poolMatches = fileContents(outputName) == expected;
+
+    // Repeat the comparison on rows with long score lines
+    std::vector<CSVData> longRows = longLineRows();
+    writeScores(outputName, longRows);
+    std::string longExpected = fileContents(outputName);
+    uringMatches &= storeAsync(uring, outputName, longRows) && fileContents(outputName) == longExpected;
+    poolMatches &= storeAsync(pool, outputName, longRows) && fileContents(outputName) == longExpected;
+
+    std::remove(outputName.c_str());
+    if (!uringMatches || !poolMatches) {
+        std::cerr << "Async writers produced different output than the stream writer" << std::endl;
+        return 1;
+    }
+
+    double outputMegabytes = expected.size() / 1048576.0;
+    std::cout << "Write (" << outputMegabytes << " MiB): stream " << outputMegabytes / streamTime.count() << " MiB/s, "
+              << uring.backendName() << " " << outputMegabytes / uringTime.count() << " MiB/s, "
+              << pool.backendName() << " " << outputMegabytes / poolTime.count() << " MiB/s" << std::endl;
+    std::cout << "Rows: " << reference.size() << std::endl;
+
+    return 0;
+}
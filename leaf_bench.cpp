@@ -0,0 +1,105 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "leaf_kernels.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Number of rows sorted per round, split into independent leaves; small enough to stay in cache
+// like the leaves of a recursive sort do
+const int kBenchRows = 1 << 13;
+
+// Number of timed rounds per measurement
+const int kBenchRounds = 200;
+
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
+// Sort key passed to the leaf kernels; a lambda rather than a function pointer so the key loads inline
+const auto leafKey = [](const CSVData& data) { return sortKey(data); };
+
+// Function to time one leaf sorting routine over all leaves of the given size, in nanoseconds per row
+template <typename SortFn>
+double timeLeaves(const std::vector<CSVData>& input, int leafSize, SortFn sortFn) {
+    std::vector<CSVData> data;
+    int leaves = static_cast<int>(input.size()) / leafSize;
+    std::chrono::duration<double, std::nano> elapsed(0);
+
+    for (int round = 0; round < kBenchRounds; round++) {
+        data = input;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int l = 0; l < leaves; l++) {
+            sortFn(data, l * leafSize, l * leafSize + leafSize - 1);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        elapsed += end - start;
+    }
+
+    for (int l = 0; l < leaves; l++) {
+        if (!std::is_sorted(data.begin() + l * leafSize, data.begin() + (l + 1) * leafSize,
+                            [](const CSVData& a, const CSVData& b) { return sortKey(a) < sortKey(b); })) {
+            std::cerr << "Leaf of size " << leafSize << " not sorted." << std::endl;
+            break;
+        }
+    }
+
+    return elapsed.count() / (static_cast<double>(leaves) * leafSize * kBenchRounds);
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 100);
+    std::vector<CSVData> input(kBenchRows);
+    for (auto& d : input) {
+        d.siteLink = "site";
+        d.optimizationOpportunities = dist(rng);
+    }
+
+#ifdef __AVX2__
+    std::cout << "Small-leaf kernel: AVX2 rank sort from " << kKernelMinSize << " rows" << std::endl;
+    std::cout << "leaf size, sortLeaf, insertion sort, sorting network, AVX2 rank sort, std::sort (ns/row)" << std::endl;
+#else
+    std::cout << "Small-leaf kernel: insertion sort (build with -mavx2 for the rank sort)" << std::endl;
+    std::cout << "leaf size, sortLeaf, insertion sort, sorting network, std::sort (ns/row)" << std::endl;
+#endif
+    for (int leafSize = 2; leafSize <= kNetworkMaxSize; leafSize++) {
+        double leafTime = timeLeaves(input, leafSize, [](std::vector<CSVData>& data, int left, int right) {
+            sortLeaf(data, left, right, leafKey);
+        });
+        double insertionTime = timeLeaves(input, leafSize, [](std::vector<CSVData>& data, int left, int right) {
+            insertionSortLeaf(data, left, right, leafKey);
+        });
+        double networkTime = timeLeaves(input, leafSize, [](std::vector<CSVData>& data, int left, int right) {
+            sortLeafByKeys(data, left, right, leafKey, true, networkSortKeys);
+        });
+        double stdTime = timeLeaves(input, leafSize, [](std::vector<CSVData>& data, int left, int right) {
+            std::sort(data.begin() + left, data.begin() + right + 1, [](const CSVData& a, const CSVData& b) {
+                return a.optimizationOpportunities < b.optimizationOpportunities;
+            });
+        });
+        std::cout << leafSize << ", " << leafTime << ", " << insertionTime << ", " << networkTime;
+#ifdef __AVX2__
+        double rankTime = timeLeaves(input, leafSize, [](std::vector<CSVData>& data, int left, int right) {
+            sortLeafByKeys(data, left, right, leafKey, true, rankSortAVX2);
+        });
+        std::cout << ", " << rankTime;
+#endif
+        std::cout << ", " << stdTime << std::endl;
+    }
+
+    return 0;
+}
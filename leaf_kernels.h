@@ -0,0 +1,284 @@
+#ifndef LEAF_KERNELS_H
+#define LEAF_KERNELS_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Largest leaf handled by the key kernels (sorting network or AVX2 rank sort)
+const int kNetworkMaxSize = 16;
+
+// Smallest leaf sorted by the AVX2 rank sort; below this, and in builds without AVX2, moving the
+// rows with a plain insertion sort is cheaper than extracting keys and permuting. Tuned with leaf_bench.
+const int kKernelMinSize = 6;
+
+// Block size used by blockPartition to buffer misplaced element offsets
+const int kPartitionBlockSize = 64;
+
+// Function to order two (key, index) pairs without branches; ties are broken by index so leaves stay stable
+inline void compareExchange(double* keys, int* idx, int a, int b) {
+    double ka = keys[a];
+    double kb = keys[b];
+    int ia = idx[a];
+    int ib = idx[b];
+    bool swap = (kb < ka) | ((kb == ka) & (ib < ia));
+    keys[a] = swap ? kb : ka;
+    keys[b] = swap ? ka : kb;
+    idx[a] = swap ? ib : ia;
+    idx[b] = swap ? ia : ib;
+}
+
+// Function to run Batcher's odd-even merge sorting network on N padded (key, index) pairs
+template <int N>
+inline void sortingNetwork(double* keys, int* idx) {
+    for (int p = 1; p < N; p *= 2) {
+        for (int k = p; k >= 1; k /= 2) {
+            for (int j = k % p; j + k < N; j += 2 * k) {
+                for (int i = 0; i < k && i + j + k < N; i++) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        compareExchange(keys, idx, i + j, i + j + k);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Function to sort up to kNetworkMaxSize keys with the smallest sorting network that fits;
+// entries past n must be padded with +inf. Always returns true. Not selected by sortLeaf, since
+// leaf_bench measures it slower than insertion sort at every leaf size; kept for comparison.
+inline bool networkSortKeys(double* keys, int* idx, int n) {
+    if (n <= 2) {
+        sortingNetwork<2>(keys, idx);
+    } else if (n <= 4) {
+        sortingNetwork<4>(keys, idx);
+    } else if (n <= 8) {
+        sortingNetwork<8>(keys, idx);
+    } else {
+        sortingNetwork<16>(keys, idx);
+    }
+    return true;
+}
+
+#ifdef __AVX2__
+// Function to sort up to 16 keys (padded with +inf, no NaN) by computing each key's rank with
+// AVX2 compares. Returns false, leaving keys and idx untouched, if the ranks are not a permutation.
+inline bool rankSortAVX2(double* keys, int* idx, int n) {
+    __m256d k[4];
+    __m256d lane[4];
+    for (int c = 0; c < 4; c++) {
+        k[c] = _mm256_loadu_pd(keys + 4 * c);
+        lane[c] = _mm256_set_pd(4 * c + 3, 4 * c + 2, 4 * c + 1, 4 * c);
+    }
+    double sortedKeys[kNetworkMaxSize];
+    int sortedIdx[kNetworkMaxSize];
+    unsigned int seen = 0;
+    for (int i = 0; i < n; i++) {
+        __m256d ki = _mm256_set1_pd(keys[i]);
+        __m256d ii = _mm256_set1_pd(static_cast<double>(i));
+        int rank = 0;
+        for (int c = 0; c < 4; c++) {
+            __m256d lt = _mm256_cmp_pd(k[c], ki, _CMP_LT_OQ);
+            __m256d eq = _mm256_and_pd(_mm256_cmp_pd(k[c], ki, _CMP_EQ_OQ), _mm256_cmp_pd(lane[c], ii, _CMP_LT_OQ));
+            rank += __builtin_popcount(_mm256_movemask_pd(_mm256_or_pd(lt, eq)));
+        }
+        rank &= kNetworkMaxSize - 1;
+        seen |= 1u << rank;
+        sortedKeys[rank] = keys[i];
+        sortedIdx[rank] = idx[i];
+    }
+    if (seen != (1u << n) - 1) {
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        keys[i] = sortedKeys[i];
+        idx[i] = sortedIdx[i];
+    }
+    return true;
+}
+#endif
+
+// Function to perform a plain insertion sort of data[left..right] (inclusive) by key. A row that
+// belongs before data[left] is moved there directly, so the inner loop needs no bounds check. Stable.
+template <typename T, typename Key>
+void insertionSortLeaf(std::vector<T>& data, int left, int right, Key key, bool ascending = true) {
+    for (int i = left + 1; i <= right; i++) {
+        double k = ascending ? key(data[i]) : -key(data[i]);
+        double first = ascending ? key(data[left]) : -key(data[left]);
+        if (k < first) {
+            T value = std::move(data[i]);
+            std::move_backward(data.begin() + left, data.begin() + i, data.begin() + i + 1);
+            data[left] = std::move(value);
+            continue;
+        }
+        int j = i;
+        if (k < (ascending ? key(data[j - 1]) : -key(data[j - 1]))) {
+            T value = std::move(data[i]);
+            do {
+                data[j] = std::move(data[j - 1]);
+                j--;
+            } while (k < (ascending ? key(data[j - 1]) : -key(data[j - 1])));
+            data[j] = std::move(value);
+        }
+    }
+}
+
+// Function to sort data[left..right] (inclusive, at most kNetworkMaxSize rows) by sorting the keys
+// together with their positions through keySort and then moving each row once. NaN keys sort last.
+// Falls back to insertion sort if keySort rejects its result. Stable.
+template <typename T, typename Key, typename KeySort>
+void sortLeafByKeys(std::vector<T>& data, int left, int right, Key key, bool ascending, KeySort keySort) {
+    int n = right - left + 1;
+    double keys[kNetworkMaxSize];
+    int idx[kNetworkMaxSize];
+    for (int i = 0; i < n; i++) {
+        double k = ascending ? key(data[left + i]) : -key(data[left + i]);
+        keys[i] = k != k ? std::numeric_limits<double>::infinity() : k;
+        idx[i] = i;
+    }
+    for (int i = n; i < kNetworkMaxSize; i++) {
+        keys[i] = std::numeric_limits<double>::infinity();
+        idx[i] = i;
+    }
+    if (!keySort(keys, idx, n)) {
+        insertionSortLeaf(data, left, right, key, ascending);
+        return;
+    }
+
+    // Apply the permutation in place one cycle at a time, so each row is moved once
+    unsigned int placed = 0;
+    for (int i = 0; i < n; i++) {
+        if (idx[i] == i || (placed >> i) & 1u) {
+            continue;
+        }
+        T value = std::move(data[left + i]);
+        int j = i;
+        while (idx[j] != i) {
+            data[left + j] = std::move(data[left + idx[j]]);
+            placed |= 1u << j;
+            j = idx[j];
+        }
+        data[left + j] = std::move(value);
+        placed |= 1u << j;
+    }
+}
+
+// Function to sort a small range data[left..right] (inclusive) by key with the fastest kernel for
+// its size: the AVX2 rank sort from kKernelMinSize to kNetworkMaxSize rows when built with AVX2,
+// and insertion sort otherwise. Stable.
+template <typename T, typename Key>
+void sortLeaf(std::vector<T>& data, int left, int right, Key key, bool ascending = true) {
+    int n = right - left + 1;
+#ifdef __AVX2__
+    if (n >= kKernelMinSize && n <= kNetworkMaxSize) {
+        sortLeafByKeys(data, left, right, key, ascending, rankSortAVX2);
+        return;
+    }
+#endif
+    if (n > 1) {
+        insertionSortLeaf(data, left, right, key, ascending);
+    }
+}
+
+// Function to move the median of data[left], data[mid] and data[right] to data[right]
+template <typename T, typename Key>
+void medianOfThreeToRight(std::vector<T>& data, int left, int right, Key key) {
+    int mid = left + (right - left) / 2;
+    if (key(data[mid]) < key(data[left])) {
+        std::swap(data[mid], data[left]);
+    }
+    if (key(data[right]) < key(data[left])) {
+        std::swap(data[right], data[left]);
+    }
+    if (key(data[mid]) < key(data[right])) {
+        std::swap(data[mid], data[right]);
+    }
+}
+
+// Function to partition data[left..right] around the pivot stored in data[right] (BlockQuicksort).
+// Misplaced elements are found with branch-free offset buffers and swapped in bulk.
+// Returns the final pivot position p: keys in [left, p) are below the pivot, keys in (p, right] are not.
+template <typename T, typename Key>
+int blockPartition(std::vector<T>& data, int left, int right, Key key) {
+    double pivot = key(data[right]);
+    int l = left;
+    int r = right - 1;
+
+    unsigned char offsetsL[kPartitionBlockSize];
+    unsigned char offsetsR[kPartitionBlockSize];
+    int numL = 0, numR = 0, startL = 0, startR = 0;
+
+    while (r - l + 1 > 2 * kPartitionBlockSize) {
+        if (numL == 0) {
+            startL = 0;
+            for (int i = 0; i < kPartitionBlockSize; i++) {
+                offsetsL[numL] = static_cast<unsigned char>(i);
+                numL += !(key(data[l + i]) < pivot);
+            }
+        }
+        if (numR == 0) {
+            startR = 0;
+            for (int i = 0; i < kPartitionBlockSize; i++) {
+                offsetsR[numR] = static_cast<unsigned char>(i);
+                numR += key(data[r - i]) < pivot;
+            }
+        }
+
+        int num = std::min(numL, numR);
+        for (int k = 0; k < num; k++) {
+            std::swap(data[l + offsetsL[startL + k]], data[r - offsetsR[startR + k]]);
+        }
+        numL -= num;
+        numR -= num;
+        startL += num;
+        startR += num;
+        if (numL == 0) {
+            l += kPartitionBlockSize;
+        }
+        if (numR == 0) {
+            r -= kPartitionBlockSize;
+        }
+    }
+
+    // Everything before l is below the pivot and everything after r is not; finish the rest directly
+    int i = l;
+    int j = r;
+    while (true) {
+        while (i <= j && key(data[i]) < pivot) {
+            i++;
+        }
+        while (i <= j && !(key(data[j]) < pivot)) {
+            j--;
+        }
+        if (i >= j) {
+            break;
+        }
+        std::swap(data[i], data[j]);
+        i++;
+        j--;
+    }
+
+    std::swap(data[i], data[right]);
+    return i;
+}
+
+// Function to move all keys equal to the pivot in data[right] to the front of data[left..right],
+// for ranges whose smallest key is known to equal the pivot. Returns the first index with a larger key.
+template <typename T, typename Key>
+int partitionEqual(std::vector<T>& data, int left, int right, Key key) {
+    double pivot = key(data[right]);
+    int i = left;
+    for (int j = left; j <= right; j++) {
+        if (!(pivot < key(data[j]))) {
+            std::swap(data[i], data[j]);
+            i++;
+        }
+    }
+    return i;
+}
+
+#endif // LEAF_KERNELS_H
@@ -5,6 +5,8 @@
 #include <omp.h>
 #include <chrono>
 #include <algorithm>
+#include "leaf_kernels.h"
+#include "verify.h"
 
 // Struct to hold data from CSV file
 struct CSVData {
@@ -83,6 +85,17 @@ double calculateSEOScore(const CSVData& data) {
     return seoScore;
 }
 
+// Ranges at or below this size are finished by the leaf kernels
+const int kMergeSortLeafSize = 16;
+
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
+// Sort key passed to the leaf kernels; a lambda rather than a function pointer so the key loads inline
+const auto leafKey = [](const CSVData& data) { return sortKey(data); };
+
 // Function to merge two sorted halves of data array
 void merge(std::vector<CSVData>& data, int left, int mid, int right) {
     int n1 = mid - left + 1;
@@ -122,8 +135,10 @@ void merge(std::vector<CSVData>& data, int left, int mid, int right) {
 
 // Function to perform merge sort
 void mergeSort(std::vector<CSVData>& data, int left, int right) {
-    if (left >= right)
+    if (right - left + 1 <= kMergeSortLeafSize) {
+        sortLeaf(data, left, right, leafKey);
         return;
+    }
 
     int mid = left + (right - left) / 2;
     #pragma omp parallel sections
@@ -145,6 +160,9 @@ int main() {
     std::string filename = "/home/divi/alexa.com_site_info.csv";
     std::vector<CSVData> data = readCSV(filename);
 
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
+
     auto start = std::chrono::high_resolution_clock::now();
 
     #pragma omp parallel
@@ -160,6 +178,10 @@ int main() {
 
     double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
 
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
     // Output the sorted data, SEO scores, sorting rate, and number of threads or cores used
     for (const auto& d : data) {
         std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
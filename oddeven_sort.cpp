@@ -5,6 +5,7 @@
 #include <chrono>
 #include <algorithm>
 #include <omp.h>
+#include "verify.h"
 
 // Struct to hold data from CSV file
 struct CSVData {
@@ -83,19 +84,24 @@ double calculateSEOScore(const CSVData& data) {
     return seoScore;
 }
 
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
 // Odd-even sort function
 void oddEvenSort(std::vector<CSVData>& data, int n) {
     bool sorted = false;
     while (!sorted) {
         sorted = true;
-        #pragma omp parallel for shared(data, n, sorted)
+        #pragma omp parallel for shared(data, n) reduction(&&:sorted)
         for (int i = 1; i < n - 1; i += 2) {
             if (data[i].optimizationOpportunities > data[i + 1].optimizationOpportunities) {
                 std::swap(data[i], data[i + 1]);
                 sorted = false;
             }
         }
-        #pragma omp parallel for shared(data, n, sorted)
+        #pragma omp parallel for shared(data, n) reduction(&&:sorted)
         for (int i = 0; i < n - 1; i += 2) {
             if (data[i].optimizationOpportunities > data[i + 1].optimizationOpportunities) {
                 std::swap(data[i], data[i + 1]);
@@ -109,6 +115,11 @@ int main() {
     std::string filename = "/home/divi/alexa.com_site_info.csv";
     std::vector<CSVData> data = readCSV(filename);
 
+    // Keep an unsorted copy for the sequential baseline, and checksum the input when verifying
+    std::vector<CSVData> sequentialData = data;
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
+
     auto start = std::chrono::high_resolution_clock::now();
 
     // Calculate SEO scores for all data
@@ -128,7 +139,7 @@ int main() {
     // Calculate speedup
     auto startSequential = std::chrono::high_resolution_clock::now();
     // Perform sequential sorting here
-    std::sort(data.begin(), data.end(), [](const CSVData& a, const CSVData& b) {
+    std::sort(sequentialData.begin(), sequentialData.end(), [](const CSVData& a, const CSVData& b) {
         return a.optimizationOpportunities < b.optimizationOpportunities;
     });
     auto endSequential = std::chrono::high_resolution_clock::now();
@@ -138,6 +149,10 @@ int main() {
     // Calculate sorting rate
     double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
 
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
     // Output the sorted data, SEO scores, sorting rate, speedup, and time taken to sort
     for (const auto& d : data) {
         std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
@@ -5,6 +5,13 @@
 #include <omp.h>
 #include <chrono>
 #include <algorithm>
+#include <cstdlib>
+#include "leaf_kernels.h"
+#include "verify.h"
+#ifdef __cpp_impl_coroutine
+#include <cstdio>
+#include "async_io.h"
+#endif
 
 // Struct to hold data from CSV file
 struct CSVData {
@@ -83,46 +90,129 @@ double calculateSEOScore(const CSVData& data) {
     return seoScore;
 }
 
+#ifdef __cpp_impl_coroutine
+// Function to parse one CSV line without its newline; the same columns as readCSV
+CSVData parseCSVLine(const char* begin, const char* end) {
+    CSVData rowData = {};
+    int column = 0;
+    const char* p = begin;
+    while (p < end) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', end - p));
+        const char* tokenEnd = comma != nullptr ? comma : end;
+        std::string token(p, tokenEnd);
+        switch (column) {
+            case 0: rowData.siteLink = token; break;
+            case 1: rowData.optimizationOpportunities = safeStod(token); break;
+            case 2: rowData.keywordGaps = safeStod(token); break;
+            case 3: rowData.easyToRankKeywords = safeStod(token); break;
+            case 4: rowData.buyerKeywords = safeStod(token); break;
+            case 5: rowData.siteRank = safeStod(token); break;
+            case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+            // Add more cases for additional columns
+        }
+        column++;
+        p = comma != nullptr ? comma + 1 : end;
+    }
+    return rowData;
+}
+
+// Function to format one score line, matching the std::cout output; returns its length
+int formatScore(const CSVData& data, char* line, size_t capacity) {
+    return std::snprintf(line, capacity, "SEO Score for %s: %g\n", data.siteLink.c_str(), calculateSEOScore(data));
+}
+#endif
+
+// Function to get the output file named by SEO_ASYNC_IO, or an empty string to use std::cout and readCSV
+std::string asyncOutputFile() {
+    const char* value = std::getenv("SEO_ASYNC_IO");
+    if (value == nullptr || value[0] == '\0') {
+        return "";
+    }
+#ifdef __cpp_impl_coroutine
+    return value;
+#else
+    std::cerr << "SEO_ASYNC_IO needs a C++20 build; using blocking I/O" << std::endl;
+    return "";
+#endif
+}
+
+// Function to load the input: through the async reader when SEO_ASYNC_IO is set, otherwise with readCSV
+std::vector<CSVData> loadInput(const std::string& filename, const std::string& asyncOutput) {
+    if (!asyncOutput.empty()) {
+#ifdef __cpp_impl_coroutine
+        IoScheduler io(kIoQueueDepth);
+        return loadLinesAsync<CSVData>(io, filename, parseCSVLine);
+#endif
+    }
+    return readCSV(filename);
+}
+
+// Function to output the score lines: to std::cout, or when SEO_ASYNC_IO is set to that file with
+// queued async writes, so formatting overlaps the disk writes. Returns false if the file write fails.
+bool outputScores(const std::vector<CSVData>& data, const std::string& asyncOutput) {
+    if (!asyncOutput.empty()) {
+#ifdef __cpp_impl_coroutine
+        IoScheduler io(kIoQueueDepth);
+        return storeLinesAsync(io, asyncOutput, data, formatScore);
+#endif
+    }
+    for (const auto& d : data) {
+        std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
+    }
+    return true;
+}
+
+// Partitions at or below this size are finished by the leaf kernels
+const int kQuicksortLeafSize = 16;
+
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
+
+// Sort key passed to the leaf kernels; a lambda rather than a function pointer so the key loads inline
+const auto leafKey = [](const CSVData& data) { return sortKey(data); };
+
 // Function to perform parallel quicksort based on SEO score
 void parallelQuicksort(std::vector<CSVData>& data, int left, int right) {
-    if (left >= right) {
+    if (right - left + 1 <= kQuicksortLeafSize) {
+        sortLeaf(data, left, right, leafKey);
         return;
     }
 
-    double pivot = (data[left].optimizationOpportunities + data[right].optimizationOpportunities) / 2; // Choosing pivot as average of first and last element
-    int i = left;
-    int j = right;
+    medianOfThreeToRight(data, left, right, leafKey);
 
-    while (i <= j) {
-        while (data[i].optimizationOpportunities < pivot) {
-            i++;
-        }
-        while (data[j].optimizationOpportunities > pivot) {
-            j--;
-        }
-        if (i <= j) {
-            std::swap(data[i], data[j]);
-            i++;
-            j--;
-        }
+    // Everything left of the range is no larger than it, so a pivot equal to data[left - 1]
+    // is the range minimum: gather its duplicates and only sort the larger keys
+    if (left > 0 && !(sortKey(data[left - 1]) < sortKey(data[right]))) {
+        parallelQuicksort(data, partitionEqual(data, left, right, leafKey), right);
+        return;
     }
 
+    int p = blockPartition(data, left, right, leafKey);
+
     #pragma omp parallel sections
     {
         #pragma omp section
         {
-            parallelQuicksort(data, left, j);
+            parallelQuicksort(data, left, p - 1);
         }
         #pragma omp section
         {
-            parallelQuicksort(data, i, right);
+            parallelQuicksort(data, p + 1, right);
         }
     }
 }
 
 int main() {
     std::string filename = "/home/divi/alexa.com_site_info.csv";
-    std::vector<CSVData> data = readCSV(filename);
+    std::string asyncOutput = asyncOutputFile();
+    std::vector<CSVData> data = loadInput(filename, asyncOutput);
+
+    // Keep an unsorted copy for the sequential baseline, and checksum the input when verifying
+    std::vector<CSVData> sequentialData = data;
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
 
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -138,10 +228,14 @@ int main() {
     std::chrono::duration<double> elapsedSeconds = end - start;
 
     double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
-    
+
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
     // Sequential version
     start = std::chrono::high_resolution_clock::now();
-    std::sort(data.begin(), data.end(), [](const CSVData& a, const CSVData& b) {
+    std::sort(sequentialData.begin(), sequentialData.end(), [](const CSVData& a, const CSVData& b) {
         return a.optimizationOpportunities < b.optimizationOpportunities;
     });
     end = std::chrono::high_resolution_clock::now();
@@ -150,8 +244,8 @@ int main() {
     double speedup = sequentialTime.count() / elapsedSeconds.count();
 
     // Output the sorted data, SEO scores, sorting rate, speedup, and number of threads or cores used
-    for (const auto& d : data) {
-        std::cout << "SEO Score for " << d.siteLink << ": " << calculateSEOScore(d) << std::endl;
+    if (!outputScores(data, asyncOutput)) {
+        return 1;
     }
     std::cout << "Sorting rate: " << sortingRate << " elements per second" << std::endl;
     std::cout << "Time taken to sort: " << elapsedSeconds.count() << " seconds" << std::endl;
@@ -0,0 +1,94 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+// Function to map a double to an unsigned key with the same ordering
+inline uint64_t orderedKey(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+// Function to map a float to an unsigned key with the same ordering
+inline uint32_t orderedKey(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 31) ? ~bits : bits | (1u << 31);
+}
+
+// Function to perform a parallel LSD radix sort over byte positions [firstByte, lastByte) of each
+// element's key; byteOf(element, b) returns byte b. Stable, so bytes below firstByte keep their input order.
+template <typename T, typename ByteFn>
+void radixSort(std::vector<T>& data, int firstByte, int lastByte, ByteFn byteOf) {
+    long n = static_cast<long>(data.size());
+    if (n < 2) {
+        return;
+    }
+
+    int numThreads = omp_get_max_threads();
+    std::vector<T> buffer(n);
+    std::vector<long> counts(static_cast<size_t>(numThreads) * 256);
+    std::vector<T>* src = &data;
+    std::vector<T>* dst = &buffer;
+
+    for (int b = firstByte; b < lastByte; b++) {
+        std::fill(counts.begin(), counts.end(), 0);
+        bool skip = false;
+
+        #pragma omp parallel num_threads(numThreads)
+        {
+            int t = omp_get_thread_num();
+            int team = omp_get_num_threads();
+            long begin = n * t / team;
+            long end = n * (t + 1) / team;
+            long* local = &counts[static_cast<size_t>(t) * 256];
+
+            // Count this thread's slice
+            for (long i = begin; i < end; i++) {
+                local[byteOf((*src)[i], b)]++;
+            }
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                // Turn the counts into scatter offsets, bucket by bucket and thread by thread
+                long offset = 0;
+                for (int digit = 0; digit < 256; digit++) {
+                    long bucketSize = 0;
+                    for (int u = 0; u < team; u++) {
+                        long c = counts[static_cast<size_t>(u) * 256 + digit];
+                        counts[static_cast<size_t>(u) * 256 + digit] = offset;
+                        offset += c;
+                        bucketSize += c;
+                    }
+                    // A byte that is the same for every element does not need a pass
+                    if (bucketSize == n) {
+                        skip = true;
+                    }
+                }
+            }
+
+            if (!skip) {
+                for (long i = begin; i < end; i++) {
+                    const T& value = (*src)[i];
+                    (*dst)[local[byteOf(value, b)]++] = value;
+                }
+            }
+        }
+
+        if (!skip) {
+            std::swap(src, dst);
+        }
+    }
+
+    if (src != &data) {
+        data.swap(buffer);
+    }
+}
+
+#endif // RADIX_SORT_H
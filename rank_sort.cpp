@@ -4,7 +4,10 @@
 #include <vector>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <omp.h>
+#include "verify.h"
 
 // Struct to hold data from CSV file
 struct CSVData {
@@ -83,63 +86,118 @@ double calculateSEOScore(const CSVData& data) {
     return seoScore;
 }
 
-int main() {
-    std::string filename = "/home/divi/alexa.com_site_info.csv";
-    std::vector<CSVData> data = readCSV(filename);
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    // Calculate SEO scores for all data
-    std::vector<double> seoScores(data.size());
-    #pragma omp parallel for
-    for (size_t i = 0; i < data.size(); ++i) {
-        seoScores[i] = calculateSEOScore(data[i]);
-    }
+// Function to get the sort key of a row
+double sortKey(const CSVData& data) {
+    return data.optimizationOpportunities;
+}
 
-    // Find the maximum optimizationOpportunities value
-    double maxOptimizationOpportunities = 0.0;
+// Rank sort function: buckets rows by key, places them stably, then orders each bucket by its exact key
+void rankSort(std::vector<CSVData>& data) {
+    // Find the range of optimizationOpportunities values
+    // (finite keys only; infinite keys would make the range unbounded)
+    double minOptimizationOpportunities = std::numeric_limits<double>::infinity();
+    double maxOptimizationOpportunities = -minOptimizationOpportunities;
     for (const auto& d : data) {
-        if (d.optimizationOpportunities > maxOptimizationOpportunities) {
-            maxOptimizationOpportunities = d.optimizationOpportunities;
+        if (std::isfinite(d.optimizationOpportunities)) {
+            minOptimizationOpportunities = std::min(minOptimizationOpportunities, d.optimizationOpportunities);
+            maxOptimizationOpportunities = std::max(maxOptimizationOpportunities, d.optimizationOpportunities);
         }
     }
+    if (minOptimizationOpportunities > maxOptimizationOpportunities) {
+        minOptimizationOpportunities = maxOptimizationOpportunities = 0.0;
+    }
+
+    // Each element is ranked by the integer bucket of its offset from the minimum; -inf joins the
+    // first bucket and +inf and NaN the last, where the per-bucket pass below orders them
+    int lastBucket = static_cast<int>(std::floor(maxOptimizationOpportunities - minOptimizationOpportunities));
+    auto bucketOf = [minOptimizationOpportunities, maxOptimizationOpportunities, lastBucket](double value) {
+        if (value <= minOptimizationOpportunities) {
+            return 0;
+        }
+        if (!(value < maxOptimizationOpportunities)) {
+            return lastBucket;
+        }
+        return static_cast<int>(std::floor(value - minOptimizationOpportunities));
+    };
 
     // Create a rank array to count the number of elements with each rank
-    std::vector<int> rank(static_cast<int>(maxOptimizationOpportunities) + 1, 0);
+    std::vector<int> rank(lastBucket + 1, 0);
     #pragma omp parallel for
     for (const auto& d : data) {
         #pragma omp atomic
-        rank[static_cast<int>(d.optimizationOpportunities)]++;
+        rank[bucketOf(d.optimizationOpportunities)]++;
     }
 
     // Update rank array to store the actual position of each element in the output array
-    for (int i = 1; i < rank.size(); i++) {
+    for (size_t i = 1; i < rank.size(); i++) {
         rank[i] += rank[i - 1];
     }
 
-    // Create the output array
+    // Create the output array; walking backwards keeps equal ranks in input order
     std::vector<CSVData> sortedData(data.size());
-    #pragma omp parallel for
     for (int i = data.size() - 1; i >= 0; i--) {
-        #pragma omp critical
-        {
-            sortedData[rank[static_cast<int>(data[i].optimizationOpportunities)] - 1] = data[i];
-            rank[static_cast<int>(data[i].optimizationOpportunities)]--;
+        sortedData[--rank[bucketOf(data[i].optimizationOpportunities)]] = data[i];
+    }
+
+    // Fractional keys share a bucket, so finish each bucket by its exact key. After placement
+    // rank[b] is where bucket b starts, so it ends where the next one starts; only buckets with
+    // at least two rows need the pass
+    auto byKey = [](const CSVData& a, const CSVData& b) {
+        return a.optimizationOpportunities < b.optimizationOpportunities;
+    };
+    int numBuckets = static_cast<int>(rank.size());
+    int numRows = static_cast<int>(sortedData.size());
+    #pragma omp parallel for schedule(static)
+    for (int b = 0; b < numBuckets; b++) {
+        int bucketEnd = b + 1 < numBuckets ? rank[b + 1] : numRows;
+        if (bucketEnd - rank[b] < 2) {
+            continue;
+        }
+        auto first = sortedData.begin() + rank[b];
+        auto last = sortedData.begin() + bucketEnd;
+        if (!std::is_sorted(first, last, byKey)) {
+            std::stable_sort(first, last, byKey);
         }
     }
 
     // Copy the sorted data back to the original array
     data = sortedData;
+}
+
+int main() {
+    std::string filename = "/home/divi/alexa.com_site_info.csv";
+    std::vector<CSVData> data = readCSV(filename);
+
+    // Keep an unsorted copy for the sequential baseline, and checksum the input when verifying
+    std::vector<CSVData> sequentialData = data;
+    bool verify = verificationEnabled();
+    uint64_t inputChecksum = verify ? permutationChecksum(data) : 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Calculate SEO scores for all data
+    std::vector<double> seoScores(data.size());
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.size(); ++i) {
+        seoScores[i] = calculateSEOScore(data[i]);
+    }
+
+    // Sort the data using parallel rank sort
+    rankSort(data);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsedSeconds = end - start;
 
     double sortingRate = static_cast<double>(data.size()) / elapsedSeconds.count();
 
+    if (verify && !verifySorted(data, sortKey, inputChecksum)) {
+        return 1;
+    }
+
     // Calculate speedup
     auto startSequential = std::chrono::high_resolution_clock::now();
     // Perform sequential sorting here
-    std::sort(data.begin(), data.end(), [](const CSVData& a, const CSVData& b) {
+    std::sort(sequentialData.begin(), sequentialData.end(), [](const CSVData& a, const CSVData& b) {
         return a.optimizationOpportunities < b.optimizationOpportunities;
     });
     auto endSequential = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,89 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <omp.h>
+
+// Function to check whether result verification was requested through the SEO_VERIFY environment variable
+inline bool verificationEnabled() {
+    const char* value = std::getenv("SEO_VERIFY");
+    return value != nullptr && std::strcmp(value, "0") != 0;
+}
+
+// Function to mix a 64-bit value (splitmix64 finalizer)
+inline uint64_t mixHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Function to hash a double by its bit pattern
+inline uint64_t hashDouble(uint64_t h, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mixHash(h ^ bits);
+}
+
+// Function to hash every field of a row
+template <typename Row>
+uint64_t hashRow(const Row& row) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : row.siteLink) {
+        h = (h ^ c) * 0x100000001b3ULL;
+    }
+    h = hashDouble(h, row.optimizationOpportunities);
+    h = hashDouble(h, row.keywordGaps);
+    h = hashDouble(h, row.easyToRankKeywords);
+    h = hashDouble(h, row.buyerKeywords);
+    h = hashDouble(h, row.siteRank);
+    h = hashDouble(h, row.dailyTimeOnSite);
+    return mixHash(h);
+}
+
+// Function to compute an order-independent checksum of all rows; equal checksums before and
+// after sorting mean no row was lost, duplicated or altered
+template <typename Row>
+uint64_t permutationChecksum(const std::vector<Row>& data) {
+    uint64_t sum = 0;
+    #pragma omp parallel for reduction(+:sum)
+    for (long i = 0; i < static_cast<long>(data.size()); ++i) {
+        sum += hashRow(data[i]);
+    }
+    return sum ^ mixHash(data.size());
+}
+
+// Function to verify that data is sorted by key and is a permutation of the input with the given checksum
+template <typename Row, typename Key>
+bool verifySorted(const std::vector<Row>& data, Key key, uint64_t inputChecksum) {
+    long n = static_cast<long>(data.size());
+    long firstViolation = n;
+    #pragma omp parallel for reduction(min:firstViolation)
+    for (long i = 1; i < n; ++i) {
+        if (key(data[i]) < key(data[i - 1]) && i < firstViolation) {
+            firstViolation = i;
+        }
+    }
+
+    bool valid = true;
+    if (firstViolation < n) {
+        std::cerr << "Verification failed: rows " << firstViolation - 1 << " and " << firstViolation
+                  << " are out of order (" << key(data[firstViolation - 1]) << " > "
+                  << key(data[firstViolation]) << ")" << std::endl;
+        valid = false;
+    }
+    if (permutationChecksum(data) != inputChecksum) {
+        std::cerr << "Verification failed: output is not a permutation of the input" << std::endl;
+        valid = false;
+    }
+    return valid;
+}
+
+#endif // VERIFY_H
@@ -0,0 +1,281 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <omp.h>
+#include "adaptive_merge.h"
+
+// Struct to hold data from CSV file
+struct CSVData {
+    std::string siteLink;
+    double optimizationOpportunities;
+    double keywordGaps;
+    double easyToRankKeywords;
+    double buyerKeywords;
+    double siteRank;
+    double dailyTimeOnSite;
+    // Add more fields as needed
+};
+
+// Number of weighted metrics in the SEO score
+const int kNumMetrics = 6;
+
+// Struct to hold one set of Weight_1..Weight_6 values
+struct WeightVector {
+    double weights[kNumMetrics];
+};
+
+// Number of top-ranked sites printed for each weight vector
+const int kTopK = 10;
+
+// Function to convert a string to double, with error handling
+double safeStod(const std::string& str) {
+    try {
+        return std::stod(str);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid argument: " << str << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cerr << "Out of range: " << str << std::endl;
+    }
+    return 0.0; // Return a default value or handle the error as needed
+}
+
+// Function to read CSV file and extract relevant data
+std::vector<CSVData> readCSV(const std::string& filename) {
+    std::vector<CSVData> data;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file." << std::endl;
+        return data;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string token;
+
+        CSVData rowData;
+        int column = 0;
+        while (std::getline(iss, token, ',')) {
+            switch (column) {
+                case 0: rowData.siteLink = token; break;
+                case 1: rowData.optimizationOpportunities = safeStod(token); break;
+                case 2: rowData.keywordGaps = safeStod(token); break;
+                case 3: rowData.easyToRankKeywords = safeStod(token); break;
+                case 4: rowData.buyerKeywords = safeStod(token); break;
+                case 5: rowData.siteRank = safeStod(token); break;
+                case 6: rowData.dailyTimeOnSite = safeStod(token); break;
+                // Add more cases for additional columns
+            }
+            column++;
+        }
+        data.push_back(rowData);
+    }
+
+    file.close();
+    return data;
+}
+
+// Function to read weight vectors, one line of six comma-separated weights each
+std::vector<WeightVector> readWeights(const std::string& filename) {
+    std::vector<WeightVector> weightVectors;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening weights file." << std::endl;
+        return weightVectors;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::string token;
+
+        WeightVector w = {};
+        int column = 0;
+        while (std::getline(iss, token, ',')) {
+            if (column < kNumMetrics) {
+                w.weights[column] = safeStod(token);
+            }
+            column++;
+        }
+        if (column != kNumMetrics) {
+            std::cerr << "Skipping weight line with " << column << " values: " << line << std::endl;
+            continue;
+        }
+        weightVectors.push_back(w);
+    }
+
+    file.close();
+    return weightVectors;
+}
+
+// Function to build a default sweep around the weights used by calculateSEOScore
+std::vector<WeightVector> defaultWeights() {
+    const WeightVector base = {{0.25, 0.20, 0.15, 0.10, 0.20, 0.10}};
+    std::vector<WeightVector> weightVectors;
+    weightVectors.push_back(base);
+    for (int k = 0; k < kNumMetrics; k++) {
+        WeightVector up = base;
+        up.weights[k] += 0.05;
+        weightVectors.push_back(up);
+        WeightVector down = base;
+        down.weights[k] -= 0.05;
+        weightVectors.push_back(down);
+    }
+    return weightVectors;
+}
+
+// Function to score every row for every weight vector in a single pass over the metric columns.
+// scores[w * n + i] holds the SEO score of row i under weight vector w, scaled like calculateSEOScore.
+std::vector<double> calculateSEOScores(const std::vector<CSVData>& data, const std::vector<WeightVector>& weightVectors) {
+    size_t n = data.size();
+    size_t numVectors = weightVectors.size();
+
+    // Lay the metrics out column by column so the scoring loop streams through contiguous arrays
+    std::vector<double> columns(kNumMetrics * n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        columns[0 * n + i] = data[i].optimizationOpportunities;
+        columns[1 * n + i] = data[i].keywordGaps;
+        columns[2 * n + i] = data[i].easyToRankKeywords;
+        columns[3 * n + i] = data[i].buyerKeywords;
+        columns[4 * n + i] = data[i].siteRank;
+        columns[5 * n + i] = data[i].dailyTimeOnSite;
+    }
+
+    // Fold the normalisation and the factor 100 into the weights once per vector
+    std::vector<double> scaled(numVectors * kNumMetrics);
+    for (size_t w = 0; w < numVectors; w++) {
+        double total = 0.0;
+        for (int k = 0; k < kNumMetrics; k++) {
+            total += weightVectors[w].weights[k];
+        }
+        for (int k = 0; k < kNumMetrics; k++) {
+            scaled[w * kNumMetrics + k] = total != 0.0 ? weightVectors[w].weights[k] / total * 100 : 0.0;
+        }
+    }
+
+    std::vector<double> scores(numVectors * n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+        double m[kNumMetrics];
+        for (int k = 0; k < kNumMetrics; k++) {
+            m[k] = columns[k * n + i];
+        }
+        for (size_t w = 0; w < numVectors; w++) {
+            const double* s = &scaled[w * kNumMetrics];
+            scores[w * n + i] = m[0] * s[0] + m[1] * s[1] + m[2] * s[2] +
+                                m[3] * s[3] + m[4] * s[4] + m[5] * s[5];
+        }
+    }
+
+    return scores;
+}
+
+// Function to compute Spearman's rank correlation between two rankings given as row -> position
+double spearmanCorrelation(const std::vector<int>& rankA, const std::vector<int>& rankB) {
+    double n = static_cast<double>(rankA.size());
+    if (rankA.size() < 2) {
+        return 1.0;
+    }
+    double sumSquares = 0.0;
+    #pragma omp parallel for reduction(+:sumSquares)
+    for (size_t i = 0; i < rankA.size(); ++i) {
+        double d = static_cast<double>(rankA[i] - rankB[i]);
+        sumSquares += d * d;
+    }
+    return 1.0 - 6.0 * sumSquares / (n * (n * n - 1.0));
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = argc > 1 ? argv[1] : "/home/divi/alexa.com_site_info.csv";
+    std::vector<CSVData> data = readCSV(filename);
+    std::vector<WeightVector> weightVectors = argc > 2 ? readWeights(argv[2]) : defaultWeights();
+    if (data.empty() || weightVectors.empty()) {
+        std::cerr << "Nothing to sweep." << std::endl;
+        return 1;
+    }
+
+    int n = data.size();
+    int numVectors = weightVectors.size();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<double> scores = calculateSEOScores(data, weightVectors);
+
+    auto scored = std::chrono::high_resolution_clock::now();
+
+    // Rank every weight vector, starting each sort from the previous permutation so that
+    // small weight changes only leave a nearly-sorted order to repair
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    std::vector<int> previousRank(n), currentRank(n);
+    std::vector<std::vector<int>> topK(numVectors);
+    std::vector<double> correlation(numVectors, 1.0);
+    std::vector<int> topKOverlap(numVectors, 0);
+    int k = std::min(kTopK, n);
+
+    for (int w = 0; w < numVectors; w++) {
+        const double* s = &scores[static_cast<size_t>(w) * n];
+        naturalMergeSort(order, [s](int a, int b) {
+            return s[a] > s[b] || (s[a] == s[b] && a < b);
+        });
+
+        #pragma omp parallel for
+        for (int pos = 0; pos < n; pos++) {
+            currentRank[order[pos]] = pos;
+        }
+        topK[w].assign(order.begin(), order.begin() + k);
+
+        if (w > 0) {
+            correlation[w] = spearmanCorrelation(previousRank, currentRank);
+            for (int idx : topK[w]) {
+                if (previousRank[idx] < k) {
+                    topKOverlap[w]++;
+                }
+            }
+        } else {
+            topKOverlap[w] = k;
+        }
+        previousRank.swap(currentRank);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> scoringSeconds = scored - start;
+    std::chrono::duration<double> elapsedSeconds = end - start;
+
+    double sweepRate = static_cast<double>(numVectors) / elapsedSeconds.count();
+
+    // Output the top-K sites and rank-correlation deltas for each weight vector
+    for (int w = 0; w < numVectors; w++) {
+        std::cout << "Weight vector " << w << ":";
+        for (int m = 0; m < kNumMetrics; m++) {
+            std::cout << " " << weightVectors[w].weights[m];
+        }
+        std::cout << std::endl;
+        for (int pos = 0; pos < k; pos++) {
+            int idx = topK[w][pos];
+            std::cout << "  " << pos + 1 << ". SEO Score for " << data[idx].siteLink << ": "
+                      << scores[static_cast<size_t>(w) * n + idx] << std::endl;
+        }
+        if (w > 0) {
+            std::cout << "  Spearman vs previous: " << correlation[w]
+                      << " (delta " << correlation[w] - 1.0 << "), top-" << k
+                      << " overlap: " << topKOverlap[w] << "/" << k << std::endl;
+        }
+    }
+    std::cout << "Weight vectors: " << numVectors << ", rows: " << n << std::endl;
+    std::cout << "Time taken to score: " << scoringSeconds.count() << " seconds" << std::endl;
+    std::cout << "Time taken to sweep: " << elapsedSeconds.count() << " seconds" << std::endl;
+    std::cout << "Sweep rate: " << sweepRate << " weight vectors per second" << std::endl;
+    std::cout << "Number of threads/cores: " << omp_get_max_threads() << std::endl;
+
+    return 0;
+}